@@ -0,0 +1,758 @@
+// Headless simulation benchmarks for PixelPhys2D
+// Build with -DBUILD_BENCHMARKS=ON and run: ./PixelPhysBench [--threads N] [scenario...]
+#include "../include/World.h"
+#include "../include/ChunkScheduler.h"
+#include <bitset>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <string>
+#include <thread>
+
+using namespace PixelPhys;
+
+namespace {
+
+using Clock = std::chrono::steady_clock;
+
+double millisecondsSince(Clock::time_point start) {
+    return std::chrono::duration<double, std::milli>(Clock::now() - start).count();
+}
+
+// Mirror what World::update does for a single chunk: re-arm it when it asked for another frame
+void stepChunk(Chunk& chunk) {
+    if (chunk.shouldUpdateNextFrame()) {
+        chunk.setDirty(true);
+    }
+    chunk.update(ChunkNeighbors{});   // No neighbours: the halo is a wall on every side
+}
+
+// Drop a square block of sand into an empty chunk and time the average update
+double runFallingBlock(int blockSize, int frames, bool forceFullScan) {
+    Chunk chunk(0, 0);
+    int startX = (Chunk::WIDTH - blockSize) / 2;
+    for (int y = 0; y < blockSize; ++y) {
+        for (int x = startX; x < startX + blockSize; ++x) {
+            chunk.set(x, y, MaterialType::Sand);
+        }
+    }
+
+    // The first update always scans the whole (freshly created) chunk
+    stepChunk(chunk);
+
+    auto start = Clock::now();
+    for (int frame = 0; frame < frames; ++frame) {
+        if (forceFullScan) {
+            chunk.markAllDirty();
+        }
+        stepChunk(chunk);
+    }
+    return millisecondsSince(start) / frames;
+}
+
+// Per-frame Chunk::update cost should follow the moving area, not the 512x512 chunk area
+void benchDirtyRect() {
+    const int FRAMES = 64;
+    std::printf("== dirty-rect: Chunk::update cost vs active area (%d frames) ==\n", FRAMES);
+    std::printf("%8s %10s %16s %16s\n", "block", "cells", "dirty-rect ms", "full-scan ms");
+    for (int blockSize : {8, 32, 64, 128, 256}) {
+        double rectMs = runFallingBlock(blockSize, FRAMES, false);
+        double fullMs = runFallingBlock(blockSize, FRAMES, true);
+        std::printf("%8d %10d %16.3f %16.3f\n", blockSize, blockSize * blockSize, rectMs, fullMs);
+    }
+}
+
+// Scattered activity: small sand blocks in the corners of a chunk whose floor has settled.
+// The dirty rect spans nearly the whole chunk; only the tiles around the blocks are awake.
+void benchTiles() {
+    const int FRAMES = 64;
+    const int BLOCK = 16;
+    std::printf("== tiles: scattered activity over a settled chunk (%d frames) ==\n", FRAMES);
+    std::printf("%10s %12s %12s %16s\n", "mode", "rect cells", "awake tiles", "ms/frame");
+    
+    for (bool forceFullScan : {false, true}) {
+        Chunk chunk(0, 0);
+        for (int y = Chunk::HEIGHT * 3 / 4; y < Chunk::HEIGHT; ++y) {
+            for (int x = 0; x < Chunk::WIDTH; ++x) {
+                chunk.set(x, y, y == Chunk::HEIGHT - 1 ? MaterialType::Stone : MaterialType::Sand);
+            }
+        }
+        // Let the floor settle completely
+        for (int frame = 0; frame < 8; ++frame) {
+            stepChunk(chunk);
+        }
+        
+        for (int corner = 0; corner < 4; ++corner) {
+            int startX = (corner & 1) ? Chunk::WIDTH - 2 * BLOCK : BLOCK;
+            int startY = (corner & 2) ? Chunk::HEIGHT / 2 : BLOCK;
+            for (int y = startY; y < startY + BLOCK; ++y) {
+                for (int x = startX; x < startX + BLOCK; ++x) {
+                    chunk.set(x, y, MaterialType::Sand);
+                }
+            }
+        }
+        
+        int rectCells = chunk.getNextDirtyRect().area();
+        int awakeTiles = static_cast<int>(std::bitset<64>(chunk.getNextAwakeTiles()).count());
+        auto start = Clock::now();
+        for (int frame = 0; frame < FRAMES; ++frame) {
+            if (forceFullScan) {
+                chunk.markAllDirty();
+            }
+            stepChunk(chunk);
+        }
+        std::printf("%10s %12d %12d %16.3f\n", forceFullScan ? "full-scan" : "tiles",
+                    rectCells, forceFullScan ? Chunk::TILES_X * Chunk::TILES_Y : awakeTiles,
+                    millisecondsSince(start) / FRAMES);
+    }
+}
+
+// Sand-heavy scenes for the powder kernels: the SDLK_t column drop, a chunk-wide pour, and a
+// settled bed of sand over the lower half of the chunk
+enum class PowderScene { Column, Pour, Bed };
+
+void fillPowderScene(Chunk& chunk, PowderScene scene) {
+    for (int x = 0; x < Chunk::WIDTH; ++x) {
+        chunk.set(x, Chunk::HEIGHT - 1, MaterialType::Stone);
+    }
+    if (scene == PowderScene::Pour) {
+        std::mt19937 rng(99);
+        for (int y = 0; y < Chunk::HEIGHT / 2; ++y) {
+            for (int x = 0; x < Chunk::WIDTH; ++x) {
+                int roll = static_cast<int>(rng() % 10);
+                if (roll < 4) chunk.set(x, y, MaterialType::Sand);
+                else if (roll < 5) chunk.set(x, y, MaterialType::Gravel);
+            }
+        }
+    } else if (scene == PowderScene::Bed) {
+        for (int y = Chunk::HEIGHT / 2; y < Chunk::HEIGHT - 1; ++y) {
+            for (int x = 0; x < Chunk::WIDTH; ++x) {
+                chunk.set(x, y, MaterialType::Sand);
+            }
+        }
+    } else {
+        int testX = Chunk::WIDTH / 2;
+        for (int x = testX - 20; x < testX + 20; ++x) {
+            for (int y = 50; y < 150; ++y) {
+                chunk.set(x, y, MaterialType::Sand);
+            }
+        }
+    }
+}
+
+// Run a powder scene with full updates or with the powder pass alone. The scenes hold nothing
+// but powders and stone inside walls, so both take the same steps. Moving scenes run until they
+// come to rest; the bed is rescanned in full every update. Returns ms per update.
+double runPowderScene(Chunk& chunk, PowderScene scene, bool powderPassOnly, int& frames) {
+    const int MAX_FRAMES = 2000;
+    const int BED_FRAMES = 64;
+    auto step = [&]() {
+        if (powderPassOnly) {
+            if (chunk.shouldUpdateNextFrame()) {
+                chunk.setDirty(true);
+            }
+            chunk.updatePowders();
+        } else {
+            stepChunk(chunk);
+        }
+    };
+    
+    if (scene == PowderScene::Bed) {
+        while (chunk.isDirty() || chunk.shouldUpdateNextFrame()) {
+            step();
+        }
+    }
+    frames = 0;
+    auto start = Clock::now();
+    if (scene == PowderScene::Bed) {
+        for (; frames < BED_FRAMES; ++frames) {
+            chunk.markAllDirty();
+            step();
+        }
+    } else {
+        while (frames < MAX_FRAMES && (chunk.isDirty() || chunk.shouldUpdateNextFrame())) {
+            step();
+            ++frames;
+        }
+    }
+    return millisecondsSince(start) / std::max(1, frames);
+}
+
+// Scalar vs bitboard powder pass: cost per full update and per powder pass alone, updates until
+// settled, and where the pile's mass ends up. The column starts centred on x = 255.5; the
+// scalar sweep's right-to-left order drifts it left (see Chunk::PowderKernel).
+void benchPowderKernel() {
+    std::printf("== powder-kernel: scalar vs bitboard powder pass ==\n");
+    std::printf("%8s %10s %12s %12s %10s %10s %10s\n",
+                "scene", "kernel", "update ms", "powder ms", "grains", "settled@", "centre x");
+    
+    const Chunk::PowderKernel previous = Chunk::getPowderKernel();
+    for (PowderScene scene : {PowderScene::Column, PowderScene::Pour, PowderScene::Bed}) {
+        for (Chunk::PowderKernel kernel : {Chunk::PowderKernel::Scalar, Chunk::PowderKernel::Bitboard}) {
+            Chunk::setPowderKernel(kernel);
+            Chunk updated(0, 0);
+            Chunk powderOnly(0, 0);
+            fillPowderScene(updated, scene);
+            fillPowderScene(powderOnly, scene);
+            
+            int frames = 0;
+            int powderFrames = 0;
+            double updateMs = runPowderScene(updated, scene, false, frames);
+            double powderMs = runPowderScene(powderOnly, scene, true, powderFrames);
+            
+            int grains = 0;
+            int diverged = 0;
+            double centre = 0.0;
+            for (int y = 0; y < Chunk::HEIGHT; ++y) {
+                for (int x = 0; x < Chunk::WIDTH; ++x) {
+                    MaterialType material = updated.get(x, y);
+                    if (material == MaterialType::Sand || material == MaterialType::Gravel) {
+                        ++grains;
+                        centre += x;
+                    }
+                    diverged += (material != powderOnly.get(x, y));
+                }
+            }
+            if (diverged != 0 || frames != powderFrames) {
+                std::printf("  powder-pass run diverged: %d cells differ, %d vs %d updates\n",
+                            diverged, powderFrames, frames);
+            }
+            const char* sceneName = scene == PowderScene::Column ? "column" : scene == PowderScene::Pour ? "pour" : "bed";
+            std::printf("%8s %10s %12.3f %12.3f %10d %10d %10.1f\n", sceneName,
+                        kernel == Chunk::PowderKernel::Scalar ? "scalar" : "bitboard",
+                        updateMs, powderMs, grains, frames, centre / std::max(1, grains));
+        }
+    }
+    Chunk::setPowderKernel(previous);
+}
+
+// Upper half of a chunk filled with a random mix of powders, liquids and gas over stone ledges
+void fillMixedScene(Chunk& chunk, unsigned seed) {
+    std::mt19937 rng(seed);
+    for (int y = 0; y < Chunk::HEIGHT / 2; ++y) {
+        for (int x = 0; x < Chunk::WIDTH; ++x) {
+            int roll = static_cast<int>(rng() % 100);
+            if (roll < 25) chunk.set(x, y, MaterialType::Sand);
+            else if (roll < 30) chunk.set(x, y, MaterialType::Gravel);
+            else if (roll < 45) chunk.set(x, y, MaterialType::Water);
+            else if (roll < 50) chunk.set(x, y, MaterialType::Oil);
+            else if (roll < 53) chunk.set(x, y, MaterialType::FlammableGas);
+        }
+    }
+    for (int ledge = 1; ledge <= 3; ++ledge) {
+        int y = Chunk::HEIGHT / 2 + ledge * Chunk::HEIGHT / 8;
+        for (int x = ledge * 64; x < Chunk::WIDTH - ledge * 64; ++x) {
+            chunk.set(x, y, MaterialType::Stone);
+        }
+    }
+    for (int x = 0; x < Chunk::WIDTH; ++x) {
+        chunk.set(x, Chunk::HEIGHT - 1, MaterialType::Stone);
+    }
+}
+
+// Multi-pass vs fused Chunk::update on mixed-material chunks
+void benchFusedUpdate() {
+    const int FRAMES = 64;
+    std::printf("== fused-update: multi-pass vs fused Chunk::update, mixed materials (%d frames) ==\n", FRAMES);
+    std::printf("%12s %10s %12s\n", "mode", "kernel", "ms/update");
+    
+    const Chunk::UpdateMode previousMode = Chunk::getUpdateMode();
+    const Chunk::PowderKernel previousKernel = Chunk::getPowderKernel();
+    for (Chunk::PowderKernel kernel : {Chunk::PowderKernel::Scalar, Chunk::PowderKernel::Bitboard}) {
+        for (Chunk::UpdateMode mode : {Chunk::UpdateMode::MultiPass, Chunk::UpdateMode::Fused}) {
+            Chunk::setPowderKernel(kernel);
+            Chunk::setUpdateMode(mode);
+            Chunk chunk(0, 0);
+            fillMixedScene(chunk, 7);
+            
+            auto start = Clock::now();
+            for (int frame = 0; frame < FRAMES; ++frame) {
+                stepChunk(chunk);
+            }
+            std::printf("%12s %10s %12.3f\n", mode == Chunk::UpdateMode::Fused ? "fused" : "multi-pass",
+                        kernel == Chunk::PowderKernel::Scalar ? "scalar" : "bitboard",
+                        millisecondsSince(start) / FRAMES);
+        }
+    }
+    Chunk::setUpdateMode(previousMode);
+    Chunk::setPowderKernel(previousKernel);
+}
+
+// Cost of an update on a lake that is still levelling out, for increasing depth. Spreading
+// reads column heights from the chunk's depth field, so this should grow with the lake's
+// area, not with area times depth.
+void benchLiquidDepth() {
+    const int FRAMES = 32;
+    std::printf("== liquid-depth: levelling a lake of increasing depth (%d frames) ==\n", FRAMES);
+    std::printf("%8s %10s %12s\n", "depth", "cells", "ms/update");
+    for (int depth : {32, 64, 128, 256, 448}) {
+        Chunk chunk(0, 0);
+        for (int x = 0; x < Chunk::WIDTH; ++x) {
+            chunk.set(x, Chunk::HEIGHT - 1, MaterialType::Stone);
+        }
+        // Left half filled to the full depth, right half to half of it
+        int cells = 0;
+        for (int x = 0; x < Chunk::WIDTH; ++x) {
+            int columnDepth = (x < Chunk::WIDTH / 2) ? depth : depth / 2;
+            for (int y = Chunk::HEIGHT - 1 - columnDepth; y < Chunk::HEIGHT - 1; ++y) {
+                chunk.set(x, y, MaterialType::Water);
+                ++cells;
+            }
+        }
+        
+        auto start = Clock::now();
+        for (int frame = 0; frame < FRAMES; ++frame) {
+            stepChunk(chunk);
+        }
+        std::printf("%8d %10d %12.3f\n", depth, cells, millisecondsSince(start) / FRAMES);
+    }
+}
+
+// Settled scenes should cost nothing: run a lake and a sand pile until every tile sleeps,
+// then time further updates. A lake's surface never stops drifting, so it relies on tiles
+// falling asleep after a run of drift-only updates. "far fire" is a burning dune put to rest
+// by Chunk::settle, the far-chunk shortcut, which must burn the fire out rather than keep it.
+void benchSettled() {
+    const int MAX_FRAMES = 8000;
+    const int FRAMES = 256;
+    std::printf("== settled: cost of a scene once it has come to rest (%d frames) ==\n", FRAMES);
+    std::printf("%8s %14s %12s %14s %10s\n", "scene", "frames-to-rest", "ms/update", "awake tiles", "fire");
+    for (const char* scene : {"lake", "dune", "far fire"}) {
+        Chunk chunk(0, 0);
+        for (int x = 0; x < Chunk::WIDTH; ++x) {
+            chunk.set(x, Chunk::HEIGHT - 1, MaterialType::Stone);
+        }
+        if (std::strcmp(scene, "lake") == 0) {
+            for (int x = 0; x < Chunk::WIDTH; ++x) {
+                int depth = (x < Chunk::WIDTH / 2) ? 200 : 100;
+                for (int y = Chunk::HEIGHT - 1 - depth; y < Chunk::HEIGHT - 1; ++y) {
+                    chunk.set(x, y, MaterialType::Water);
+                }
+            }
+        } else {
+            const bool burning = std::strcmp(scene, "far fire") == 0;
+            for (int y = 100; y < 300; ++y) {
+                for (int x = 100; x < 400; ++x) {
+                    chunk.set(x, y, (burning && (x + y) % 7 == 0) ? MaterialType::Fire : MaterialType::Sand);
+                }
+            }
+        }
+
+        int framesToRest = 0;
+        if (std::strcmp(scene, "far fire") == 0) {
+            chunk.settle();
+        }
+        while (framesToRest < MAX_FRAMES && (chunk.isDirty() || chunk.shouldUpdateNextFrame())) {
+            stepChunk(chunk);
+            ++framesToRest;
+        }
+
+        auto start = Clock::now();
+        for (int frame = 0; frame < FRAMES; ++frame) {
+            stepChunk(chunk);
+        }
+        int fire = 0;
+        for (int y = 0; y < Chunk::HEIGHT; ++y) {
+            for (int x = 0; x < Chunk::WIDTH; ++x) {
+                fire += chunk.get(x, y) == MaterialType::Fire;
+            }
+        }
+        std::printf("%8s %14d %12.4f %14zu %10d\n", scene, framesToRest, millisecondsSince(start) / FRAMES,
+                    std::bitset<64>(chunk.getNextAwakeTiles()).count(), fire);
+    }
+}
+
+// Highest thread count the scaling scenarios try (--threads N, default: all hardware threads)
+int g_maxThreads = 0;
+
+// A block of chunks above a stone floor, by default with their upper halves full of falling
+// sand and water
+struct ChunkGrid {
+    int chunksX;
+    int chunksY;
+    std::vector<std::unique_ptr<Chunk>> chunks;
+    
+    ChunkGrid(int countX, int countY, bool fill = true) : chunksX(countX), chunksY(countY) {
+        std::mt19937 rng(1234);
+        for (int cy = 0; cy < chunksY; ++cy) {
+            for (int cx = 0; cx < chunksX; ++cx) {
+                auto chunk = std::make_unique<Chunk>(cx * Chunk::WIDTH, cy * Chunk::HEIGHT);
+                for (int y = 0; fill && y < Chunk::HEIGHT / 2; ++y) {
+                    for (int x = 0; x < Chunk::WIDTH; ++x) {
+                        int roll = static_cast<int>(rng() % 10);
+                        if (roll < 3) chunk->set(x, y, MaterialType::Sand);
+                        else if (roll < 5) chunk->set(x, y, MaterialType::Water);
+                    }
+                }
+                if (cy == chunksY - 1) {
+                    for (int x = 0; x < Chunk::WIDTH; ++x) {
+                        chunk->set(x, Chunk::HEIGHT - 1, MaterialType::Stone);
+                    }
+                }
+                chunks.push_back(std::move(chunk));
+            }
+        }
+    }
+    
+    Chunk* at(int cx, int cy) {
+        if (cx < 0 || cx >= chunksX || cy < 0 || cy >= chunksY) return nullptr;
+        return chunks[cy * chunksX + cx].get();
+    }
+    
+    // One simulation frame through the checkerboard scheduler
+    void step(ChunkScheduler& scheduler) {
+        for (int cy = 0; cy < chunksY; ++cy) {
+            for (int cx = 0; cx < chunksX; ++cx) {
+                Chunk* chunk = at(cx, cy);
+                if (chunk->shouldUpdateNextFrame()) {
+                    chunk->setDirty(true);
+                }
+                ChunkNeighbors neighbors;
+                for (int dy = -1; dy <= 1; ++dy) {
+                    for (int dx = -1; dx <= 1; ++dx) {
+                        if (dx != 0 || dy != 0) neighbors.at(dx, dy) = at(cx + dx, cy + dy);
+                    }
+                }
+                scheduler.addChunk(cx, cy, chunk, neighbors);
+            }
+        }
+        scheduler.run();
+    }
+};
+
+// Frame time of the phase scheduler for increasing thread counts on a busy 16x4 chunk grid
+void benchThreads() {
+    const int FRAMES = 8;
+    const int CHUNKS_X = 16;
+    const int CHUNKS_Y = 4;
+    int maxThreads = g_maxThreads > 0 ? g_maxThreads
+                                      : std::max(1, static_cast<int>(std::thread::hardware_concurrency()));
+    
+    std::printf("== threads: checkerboard scheduler scaling, %dx%d chunks (%d frames) ==\n",
+                CHUNKS_X, CHUNKS_Y, FRAMES);
+    std::printf("%8s %12s %10s\n", "threads", "ms/frame", "speedup");
+    double baseMs = 0.0;
+    for (int threads = 1; ; threads = std::min(threads * 2, maxThreads)) {
+        ChunkGrid grid(CHUNKS_X, CHUNKS_Y);
+        ChunkScheduler scheduler(threads);
+        
+        // The first frame scans every chunk completely
+        grid.step(scheduler);
+        
+        auto start = Clock::now();
+        for (int frame = 0; frame < FRAMES; ++frame) {
+            grid.step(scheduler);
+        }
+        double ms = millisecondsSince(start) / FRAMES;
+        if (threads == 1) baseMs = ms;
+        std::printf("%8d %12.3f %9.2fx\n", threads, ms, baseMs / ms);
+        
+        if (threads >= maxThreads) break;
+    }
+}
+
+// A block of sand and one of water dropped from the top of a column of chunks: updates until
+// everything has landed and every chunk is idle again. Falls speed up to MAX_FALL_SPEED cells
+// per update and carry their speed from chunk to chunk.
+void benchFreeFall() {
+    const int CHUNKS_Y = 4;
+    const int BLOCK = 32;
+    const int MAX_FRAMES = 20000;
+    std::printf("== free-fall: blocks dropped through %d chunks ==\n", CHUNKS_Y);
+    std::printf("%8s %12s %12s %12s\n", "block", "to-land", "to-rest", "total ms");
+    for (MaterialType material : {MaterialType::Sand, MaterialType::Water}) {
+        ChunkGrid grid(1, CHUNKS_Y, false);
+        ChunkScheduler scheduler(1);
+        Chunk* top = grid.at(0, 0);
+        Chunk* bottom = grid.at(0, CHUNKS_Y - 1);
+        const int startX = (Chunk::WIDTH - BLOCK) / 2;
+        for (int y = 0; y < BLOCK; ++y) {
+            for (int x = startX; x < startX + BLOCK; ++x) {
+                top->set(x, y, material);
+            }
+        }
+        
+        // Landed once the cell right above the floor in the block's middle column is filled
+        int toLand = 0;
+        int frames = 0;
+        auto active = [&grid]() {
+            for (const auto& chunk : grid.chunks) {
+                if (chunk->isDirty() || chunk->shouldUpdateNextFrame()) return true;
+            }
+            return false;
+        };
+        auto start = Clock::now();
+        while (frames < MAX_FRAMES && active()) {
+            grid.step(scheduler);
+            ++frames;
+            if (toLand == 0 && bottom->get(Chunk::WIDTH / 2, Chunk::HEIGHT - 2) == material) {
+                toLand = frames;
+            }
+        }
+        std::printf("%8s %12d %12d %12.1f\n", material == MaterialType::Sand ? "sand" : "water",
+                    toLand, frames, millisecondsSince(start));
+    }
+}
+
+// World::set per cell vs the bulk edit primitives, filling and clearing a whole world
+void benchBulkEdit() {
+    const int WIDTH = 4 * Chunk::WIDTH;
+    const int HEIGHT = 4 * Chunk::HEIGHT;
+    const int BRUSH = 24;
+    std::printf("== bulk-edit: per-cell set vs bulk edits, %dx%d world ==\n", WIDTH, HEIGHT);
+    std::printf("%12s %12s %12s\n", "edit", "set ms", "bulk ms");
+    World world(WIDTH, HEIGHT);
+    
+    for (MaterialType material : {MaterialType::Sand, MaterialType::Empty}) {
+        auto start = Clock::now();
+        for (int y = 0; y < HEIGHT; ++y) {
+            for (int x = 0; x < WIDTH; ++x) {
+                world.set(x, y, material);
+            }
+        }
+        double setMs = millisecondsSince(start);
+        world.fillRect(0, 0, WIDTH, HEIGHT, material == MaterialType::Sand ? MaterialType::Empty : MaterialType::Sand);
+        start = Clock::now();
+        world.fillRect(0, 0, WIDTH, HEIGHT, material);
+        std::printf("%12s %12.1f %12.1f\n", material == MaterialType::Sand ? "fill" : "clear",
+                    setMs, millisecondsSince(start));
+    }
+    
+    // A stroke of brush dabs across the world, like dragging the mouse
+    auto start = Clock::now();
+    for (int cx = BRUSH; cx < WIDTH - BRUSH; cx += 4) {
+        for (int dy = -BRUSH; dy <= BRUSH; ++dy) {
+            for (int dx = -BRUSH; dx <= BRUSH; ++dx) {
+                if (dx * dx + dy * dy <= BRUSH * BRUSH) {
+                    world.set(cx + dx, HEIGHT / 2 + dy, MaterialType::Water);
+                }
+            }
+        }
+    }
+    double setMs = millisecondsSince(start);
+    start = Clock::now();
+    for (int cx = BRUSH; cx < WIDTH - BRUSH; cx += 4) {
+        world.paintCircle(cx, HEIGHT / 2 + 3 * BRUSH, BRUSH, MaterialType::Water);
+    }
+    std::printf("%12s %12.1f %12.1f\n", "brush", setMs, millisecondsSince(start));
+}
+
+// Reading a screen-sized rectangle that straddles four chunks: World::get per cell vs a
+// RegionView, point by point and row by row
+void benchRegionView() {
+    const int SIZE = 1024;
+    const int ORIGIN = Chunk::WIDTH - SIZE / 2;
+    const int REPEATS = 8;
+    std::printf("== region-view: reading %dx%d cells across 4 chunks (%d passes) ==\n", SIZE, SIZE, REPEATS);
+    std::printf("%12s %12s %12s\n", "reader", "ns/cell", "solid");
+    World world(2 * Chunk::WIDTH, 2 * Chunk::HEIGHT);
+    world.editRect(0, 0, 2 * Chunk::WIDTH, 2 * Chunk::HEIGHT, [](int x, int y, MaterialType) {
+        return ((x * 7 + y * 13) % 5 == 0) ? MaterialType::Stone : MaterialType::Empty;
+    });
+    
+    auto report = [](const char* name, double ms, long solid) {
+        std::printf("%12s %12.2f %12ld\n", name, ms * 1e6 / (double(SIZE) * SIZE * REPEATS), solid);
+    };
+    
+    long solid = 0;
+    auto start = Clock::now();
+    for (int pass = 0; pass < REPEATS; ++pass) {
+        for (int y = ORIGIN; y < ORIGIN + SIZE; ++y) {
+            for (int x = ORIGIN; x < ORIGIN + SIZE; ++x) {
+                solid += world.get(x, y) != MaterialType::Empty;
+            }
+        }
+    }
+    report("get", millisecondsSince(start), solid);
+    
+    solid = 0;
+    start = Clock::now();
+    for (int pass = 0; pass < REPEATS; ++pass) {
+        RegionView region = world.view(ORIGIN, ORIGIN, SIZE, SIZE);
+        for (int y = ORIGIN; y < ORIGIN + SIZE; ++y) {
+            for (int x = ORIGIN; x < ORIGIN + SIZE; ++x) {
+                solid += region.get(x, y) != MaterialType::Empty;
+            }
+        }
+    }
+    report("view-get", millisecondsSince(start), solid);
+    
+    solid = 0;
+    start = Clock::now();
+    for (int pass = 0; pass < REPEATS; ++pass) {
+        RegionView region = world.view(ORIGIN, ORIGIN, SIZE, SIZE);
+        for (const ChunkView& view : region.getChunkViews()) {
+            for (int y = view.y; y < view.y + view.height; ++y) {
+                const Cell* row = view.row(y);
+                for (int i = 0; i < view.width; ++i) {
+                    solid += row[i].material != MaterialType::Empty;
+                }
+            }
+        }
+    }
+    report("view-rows", millisecondsSince(start), solid);
+}
+
+// Cost of an update with and without reacting cells. Sand pouring through a stone cave has
+// nothing to react and should skip the reaction sweep; a burning oil pool and lava poured
+// into water run the reaction kernel on every awake tile.
+void benchReactions() {
+    const int FRAMES = 64;
+    std::printf("== reactions: Chunk::update cost by scene (%d frames) ==\n", FRAMES);
+    std::printf("%10s %12s %14s\n", "scene", "ms/update", "non-empty");
+    for (const char* scene : {"inert", "burning", "quench"}) {
+        Chunk chunk(0, 0);
+        Chunk::Editor editor(chunk);
+        if (std::strcmp(scene, "inert") == 0) {
+            for (int y = 0; y < Chunk::HEIGHT; ++y) {
+                editor.fillSpan(0, Chunk::WIDTH - 1, y, MaterialType::Stone);
+                if (y >= 32 && y < Chunk::HEIGHT - 32) {
+                    editor.fillSpan(32, Chunk::WIDTH - 33, y, MaterialType::Empty);
+                }
+            }
+            for (int y = 32; y < 288; ++y) {
+                editor.fillSpan(128, 383, y, MaterialType::Sand);
+            }
+        } else {
+            editor.fillSpan(0, Chunk::WIDTH - 1, Chunk::HEIGHT - 1, MaterialType::Stone);
+            const bool burning = std::strcmp(scene, "burning") == 0;
+            for (int y = Chunk::HEIGHT - 129; y < Chunk::HEIGHT - 1; ++y) {
+                editor.fillSpan(0, Chunk::WIDTH - 1, y, burning ? MaterialType::Oil : MaterialType::Water);
+            }
+            for (int y = 0; y < 64; ++y) {
+                editor.fillSpan(192, 319, y, burning ? MaterialType::Fire : MaterialType::Lava);
+            }
+        }
+        editor.commit();
+        
+        auto start = Clock::now();
+        for (int frame = 0; frame < FRAMES; ++frame) {
+            stepChunk(chunk);
+        }
+        const double ms = millisecondsSince(start) / FRAMES;
+        
+        long nonEmpty = 0;
+        for (int y = 0; y < Chunk::HEIGHT; ++y) {
+            for (int x = 0; x < Chunk::WIDTH; ++x) {
+                nonEmpty += chunk.get(x, y) != MaterialType::Empty;
+            }
+        }
+        std::printf("%10s %12.3f %14ld\n", scene, ms, nonEmpty);
+    }
+}
+
+void benchColorize() {
+    const int PASSES = 64;
+    std::printf("== colorize: full-chunk vs changed-cell recolouring (%d passes) ==\n", PASSES);
+    std::printf("%10s %12s\n", "scene", "us/chunk");
+    for (const char* scene : {"empty", "stone", "terrain"}) {
+        Chunk chunk(0, 0);
+        Chunk::Editor editor(chunk);
+        if (std::strcmp(scene, "stone") == 0) {
+            for (int y = 0; y < Chunk::HEIGHT; ++y) {
+                editor.fillSpan(0, Chunk::WIDTH - 1, y, MaterialType::Stone);
+            }
+        } else if (std::strcmp(scene, "terrain") == 0) {
+            // Every material, in short runs
+            std::mt19937 rng(7);
+            const int materials = static_cast<int>(MaterialType::COUNT);
+            for (int y = 0; y < Chunk::HEIGHT; ++y) {
+                for (int x = 0; x < Chunk::WIDTH; x += 4) {
+                    const int material = static_cast<int>(rng() % materials);
+                    editor.fillSpan(x, x + 3, y, static_cast<MaterialType>(material));
+                }
+            }
+        }
+        editor.commit();
+        
+        auto start = Clock::now();
+        for (int pass = 0; pass < PASSES; ++pass) {
+            chunk.updatePixelData();
+        }
+        std::printf("%10s %12.1f\n", scene, millisecondsSince(start) * 1000.0 / PASSES);
+    }
+    
+    // Recolouring only what changed: scattered single-cell edits on a full chunk
+    std::printf("%10s %12s\n", "changed", "us/recolor");
+    Chunk chunk(0, 0);
+    Chunk::Editor editor(chunk);
+    for (int y = 0; y < Chunk::HEIGHT; ++y) {
+        editor.fillSpan(0, Chunk::WIDTH - 1, y, MaterialType::Stone);
+    }
+    editor.commit();
+    chunk.updatePixelData();
+    std::mt19937 rng(11);
+    for (int changed : {3, 300, 30000}) {
+        double micros = 0.0;
+        for (int pass = 0; pass < PASSES; ++pass) {
+            for (int i = 0; i < changed; ++i) {
+                const int x = static_cast<int>(rng() % Chunk::WIDTH);
+                const int y = static_cast<int>(rng() % Chunk::HEIGHT);
+                editor.set(x, y, editor.get(x, y) == MaterialType::Stone ? MaterialType::Sand : MaterialType::Stone);
+            }
+            editor.commit();
+            auto start = Clock::now();
+            chunk.updateChangedPixels();
+            micros += millisecondsSince(start) * 1000.0;
+        }
+        std::printf("%10d %12.1f\n", changed, micros / PASSES);
+    }
+}
+
+struct Scenario {
+    const char* name;
+    void (*run)();
+};
+
+const Scenario SCENARIOS[] = {
+    {"dirty-rect", benchDirtyRect},
+    {"tiles", benchTiles},
+    {"powder-kernel", benchPowderKernel},
+    {"fused-update", benchFusedUpdate},
+    {"liquid-depth", benchLiquidDepth},
+    {"settled", benchSettled},
+    {"threads", benchThreads},
+    {"free-fall", benchFreeFall},
+    {"bulk-edit", benchBulkEdit},
+    {"region-view", benchRegionView},
+    {"reactions", benchReactions},
+    {"colorize", benchColorize},
+};
+
+} // namespace
+
+int main(int argc, char* argv[]) {
+    bool ranAny = false;
+    for (int i = 1; i < argc; ++i) {
+        if (std::strcmp(argv[i], "--threads") == 0 && i + 1 < argc) {
+            g_maxThreads = std::atoi(argv[++i]);
+            continue;
+        }
+        
+        bool found = false;
+        for (const auto& scenario : SCENARIOS) {
+            if (std::strcmp(argv[i], scenario.name) == 0) {
+                scenario.run();
+                found = true;
+                ranAny = true;
+            }
+        }
+        if (!found) {
+            std::fprintf(stderr, "Unknown scenario: %s\nAvailable:", argv[i]);
+            for (const auto& scenario : SCENARIOS) {
+                std::fprintf(stderr, " %s", scenario.name);
+            }
+            std::fprintf(stderr, "\n");
+            return 1;
+        }
+    }
+
+    // No arguments: run everything
+    if (!ranAny) {
+        for (const auto& scenario : SCENARIOS) {
+            scenario.run();
+        }
+    }
+    return 0;
+}
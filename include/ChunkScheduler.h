@@ -0,0 +1,100 @@
+#pragma once
+
+#include <atomic>
+#include <condition_variable>
+#include <cstdint>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+namespace PixelPhys {
+
+class Chunk;
+
+// The eight chunks around a chunk (nullptr where none is loaded). Chunk::update reads them
+// into its halo before simulating and writes the halo cells it changed back afterwards.
+struct ChunkNeighbors {
+    Chunk* chunks[3][3] = {};   // [dy + 1][dx + 1], the centre entry is unused
+
+    Chunk* at(int dx, int dy) const { return chunks[dy + 1][dx + 1]; }
+    Chunk*& at(int dx, int dy) { return chunks[dy + 1][dx + 1]; }
+};
+
+// Fixed set of worker threads that run batches of independent jobs.
+// The calling thread takes part in every batch, so a pool of N threads has N - 1 workers.
+class ThreadPool {
+public:
+    // threadCount <= 0 uses every hardware thread
+    explicit ThreadPool(int threadCount = 0);
+    ~ThreadPool();
+
+    ThreadPool(const ThreadPool&) = delete;
+    ThreadPool& operator=(const ThreadPool&) = delete;
+
+    // Total number of threads that run jobs (workers plus the caller)
+    int getThreadCount() const { return static_cast<int>(m_workers.size()) + 1; }
+
+    // Run job(i) for every i in [0, count) and return once all of them have finished.
+    // Returning is the barrier: everything the jobs wrote is visible to the caller.
+    void parallelFor(int count, const std::function<void(int)>& job);
+
+private:
+    std::vector<std::thread> m_workers;
+
+    // Current batch, guarded by m_mutex (m_nextJob is claimed lock-free)
+    std::mutex m_mutex;
+    std::condition_variable m_batchReady;
+    std::condition_variable m_batchDone;
+    const std::function<void(int)>* m_job = nullptr;
+    int m_jobCount = 0;
+    std::atomic<int> m_nextJob{0};
+    int m_busyWorkers = 0;
+    uint64_t m_batchId = 0;
+    bool m_stopping = false;
+
+    void workerLoop();
+
+    // Claim and run jobs of the current batch until none are left
+    void runJobs();
+};
+
+// Runs Chunk::update for a set of chunks in four checkerboard phases.
+// Chunks are grouped by the parity of their chunk coordinates (2x2 pattern), so no two
+// chunks of the same phase touch each other: an update only writes into its own cells and
+// the edge cells of its eight neighbours (through its halo). Each phase runs on the thread pool
+// and the next phase starts only after the whole previous one has finished.
+class ChunkScheduler {
+public:
+    explicit ChunkScheduler(int threadCount = 0);
+
+    // Resize the worker pool (<= 0 uses every hardware thread)
+    void setThreadCount(int threadCount);
+    int getThreadCount() const { return m_pool->getThreadCount(); }
+
+    // Queue a chunk for the next run() together with the neighbours it may write into.
+    // When updateMicros is given, run() stores how long the chunk's update took there.
+    void addChunk(int chunkX, int chunkY, Chunk* chunk, const ChunkNeighbors& neighbors,
+                  float* updateMicros = nullptr);
+
+    // Number of chunks queued for the next run()
+    int getQueuedCount() const;
+
+    // Update every queued chunk phase by phase, then clear the queue
+    void run();
+
+private:
+    struct Job {
+        Chunk* chunk;
+        ChunkNeighbors neighbors;
+        float* updateMicros;
+    };
+
+    static constexpr int PHASE_COUNT = 4;
+    std::vector<Job> m_phases[PHASE_COUNT];
+
+    std::unique_ptr<ThreadPool> m_pool;
+};
+
+} // namespace PixelPhys
@@ -0,0 +1,55 @@
+#pragma once
+
+#include "MaterialRegistry.h"
+#include <cstddef>
+#include <cstdint>
+
+namespace PixelPhys {
+
+struct Cell;
+
+// Precomputed colours of the materials: VARIANTS shades of each material, built from its base
+// colour, colour variation and texture. A cell's shade is picked by its position through a
+// fixed PATTERN_SIZE x PATTERN_SIZE pattern of variant indices, so colourizing a cell is one
+// table gather. Chunks are aligned to the pattern, so chunk-local and world coordinates give
+// the same shade and the chunk pixels, World::set and the renderer all agree on a cell.
+class MaterialPalette {
+public:
+    static constexpr int VARIANTS = 64;
+    static constexpr int PATTERN_SIZE = 64;
+    
+    // Colour of a material at a position (RGBA, alpha from the material's transparency)
+    static MaterialColor color(MaterialType material, int x, int y) {
+        return s_colors.shades[colorIndex(material, s_pattern.variants[y & (PATTERN_SIZE - 1)][x & (PATTERN_SIZE - 1)])];
+    }
+    
+    // Write the RGBA bytes of 'count' consecutive cells of a row, the first one at (x, y).
+    // Uses AVX2 gathers when the CPU has them.
+    static void colorizeRow(const Cell* cells, int count, int x, int y, uint8_t* pixels);
+    
+    // Rebuild the shades from MaterialRegistry::tables(), after definitions are loaded. Not
+    // thread-safe: call it while nothing is colourizing.
+    static void rebuild();
+    
+    // Every shade, VARIANTS per material id (ids outside the enum stay transparent black)
+    struct Colors {
+        MaterialColor shades[MaterialTables::CAPACITY * VARIANTS];
+    };
+    
+    // Variant index per position. Each row repeats its first 8 entries at the end, so the
+    // variants of 8 consecutive cells are always one contiguous run, even across the end of
+    // the row (the AVX2 colouring loads them 8 at a time).
+    struct Pattern {
+        uint8_t variants[PATTERN_SIZE][PATTERN_SIZE + 8];
+    };
+    
+private:
+    static std::size_t colorIndex(MaterialType material, uint8_t variant) {
+        return static_cast<std::size_t>(material) * VARIANTS + variant;
+    }
+    
+    static Colors s_colors;
+    static const Pattern s_pattern;
+};
+
+} // namespace PixelPhys
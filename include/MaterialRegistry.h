@@ -0,0 +1,165 @@
+#pragma once
+
+#include "Materials.h"
+#include "PhysicsConstants.h"
+#include <cstddef>
+#include <cstdint>
+#include <string>
+
+namespace PixelPhys {
+
+// Bits of MaterialTables::flags
+enum MaterialFlag : uint8_t {
+    MATERIAL_SOLID     = 1 << 0,
+    MATERIAL_LIQUID    = 1 << 1,
+    MATERIAL_POWDER    = 1 << 2,
+    MATERIAL_GAS       = 1 << 3,
+    MATERIAL_FLAMMABLE = 1 << 4,
+    MATERIAL_PASSABLE  = 1 << 5
+};
+
+// Four colour channels, one 32-bit word per material so a whole colour is a single gather
+struct MaterialColor {
+    uint8_t r = 0;
+    uint8_t g = 0;
+    uint8_t b = 0;
+    uint8_t a = 0;
+};
+static_assert(sizeof(MaterialColor) == 4, "MaterialColor should stay one 32-bit word");
+
+// A reaction of a material with a neighbouring cell: on a 1-in-'chance' roll per neighbour and
+// update (1: always), the material turns into 'product' and the neighbour into
+// 'neighborProduct'. The neighbour is one material, or any material with all of
+// 'neighborFlags' when those are set.
+struct MaterialReaction {
+    uint8_t chance = 0;                                   // 0: unused slot
+    MaterialType neighbor = MaterialType::Empty;
+    uint8_t neighborFlags = 0;                            // MaterialFlag bits
+    MaterialType product = MaterialType::Empty;
+    MaterialType neighborProduct = MaterialType::Empty;
+    uint8_t blast = 0;                                    // Radius that bursts into 'product' too
+};
+
+// A material that runs out on its own: on a 'percent' roll per update, or when a cell's life
+// (see MaterialTables::lifetime) reaches zero
+struct MaterialDecay {
+    uint8_t percent = 0;                                  // 0: never decays
+    MaterialType product = MaterialType::Empty;
+};
+
+// Material properties as structure-of-arrays tables, one array per field indexed by
+// MaterialType. The hot loops read the field they need from a compact array instead of
+// whole MaterialProperties. Every array has an entry for each possible 8-bit material id,
+// so gathers indexed by raw cell materials never need a bounds clamp.
+struct alignas(64) MaterialTables {
+    static constexpr std::size_t CAPACITY = 256;
+    static constexpr std::size_t COUNT = static_cast<std::size_t>(MaterialType::COUNT);
+    static_assert(COUNT <= CAPACITY, "material ids are 8 bits");
+    
+    alignas(64) uint8_t flags[CAPACITY] = {};           // MaterialFlag bits
+    alignas(64) MaterialColor color[CAPACITY] = {};     // Base colour, alpha from transparency
+    alignas(64) MaterialColor variation[CAPACITY] = {}; // Colour variation per channel (alpha unused)
+    alignas(64) uint16_t density[CAPACITY] = {};        // kg/m^3
+    alignas(64) uint8_t inertia[CAPACITY] = {};         // Powders: resistance to being knocked loose (0-100)
+    alignas(64) uint8_t dispersal[CAPACITY] = {};       // Liquids: how far they search for space
+    
+    // Reactions with neighbours, in order: the first one that matches a neighbour applies
+    static constexpr std::size_t MAX_REACTIONS = 4;
+    alignas(64) MaterialReaction reactions[CAPACITY][MAX_REACTIONS] = {};
+    alignas(64) MaterialDecay decay[CAPACITY] = {};
+    alignas(64) uint8_t lifetime[CAPACITY] = {};        // Updates a new cell lasts if it decays (0: no limit)
+    
+    constexpr MaterialTables() = default;
+    
+    // Tables of the built-in materials
+    constexpr explicit MaterialTables(const std::array<MaterialProperties, COUNT>& properties) {
+        for (std::size_t i = 0; i < COUNT; ++i) {
+            const MaterialProperties& props = properties[i];
+            flags[i] = static_cast<uint8_t>((props.isSolid ? MATERIAL_SOLID : 0) |
+                                            (props.isLiquid ? MATERIAL_LIQUID : 0) |
+                                            (props.isPowder ? MATERIAL_POWDER : 0) |
+                                            (props.isGas ? MATERIAL_GAS : 0) |
+                                            (props.isFlammable ? MATERIAL_FLAMMABLE : 0) |
+                                            (props.isPassable ? MATERIAL_PASSABLE : 0));
+            color[i] = {props.r, props.g, props.b, props.transparency};
+            variation[i] = {props.varR, props.varG, props.varB, 0};
+            density[i] = props.density;
+            inertia[i] = props.inertialResistance;
+            dispersal[i] = props.dispersalRate;
+        }
+        
+        // Fire spreads to anything flammable and burns out; flammable liquids catch fire from
+        // it and flammable gases explode; water cools lava into stone
+        addReaction(MaterialType::Fire, {20, MaterialType::Empty, MATERIAL_FLAMMABLE, MaterialType::Fire, MaterialType::Fire, 0});
+        decay[static_cast<std::size_t>(MaterialType::Fire)] = {2, MaterialType::Empty};
+        lifetime[static_cast<std::size_t>(MaterialType::Fire)] = Physics::FIRE_LIFETIME;
+        for (std::size_t i = 0; i < COUNT; ++i) {
+            const MaterialType material = static_cast<MaterialType>(i);
+            if (!is(material, MATERIAL_FLAMMABLE)) continue;
+            if (is(material, MATERIAL_LIQUID)) {
+                addReaction(material, {10, MaterialType::Fire, 0, MaterialType::Fire, MaterialType::Fire, 0});
+            } else if (is(material, MATERIAL_GAS)) {
+                addReaction(material, {1, MaterialType::Fire, 0, MaterialType::Fire, MaterialType::Fire, 2});
+            }
+        }
+        addReaction(MaterialType::Water, {1, MaterialType::Lava, 0, MaterialType::Stone, MaterialType::Lava, 0});
+        addReaction(MaterialType::Lava, {1, MaterialType::Water, 0, MaterialType::Lava, MaterialType::Stone, 0});
+    }
+    
+    // Append a reaction to a material's list; false if the list is full
+    constexpr bool addReaction(MaterialType material, const MaterialReaction& reaction) {
+        for (MaterialReaction& slot : reactions[static_cast<std::size_t>(material)]) {
+            if (slot.chance == 0) {
+                slot = reaction;
+                return true;
+            }
+        }
+        return false;
+    }
+    
+    constexpr bool is(MaterialType material, uint8_t flag) const {
+        return (flags[static_cast<std::size_t>(material)] & flag) != 0;
+    }
+};
+
+// Built into the binary: what the registry holds until a definition file is loaded
+inline constexpr MaterialTables BUILTIN_MATERIAL_TABLES{MATERIAL_PROPERTIES};
+
+// The materials the game runs with. Starts out as the built-in set, constant-initialized so
+// a run without a definition file does no work at startup; loadDefinitions() then tunes
+// materials from a file without recompiling. Material ids come from the MaterialType enum,
+// so a file can change existing materials but not add new ones.
+class MaterialRegistry {
+public:
+    static const MaterialTables& tables() { return s_tables; }
+    
+    // Display name of a material ("Unknown" for ids outside the enum)
+    static const char* name(MaterialType material);
+    
+    // Material with the given name (case-insensitive); false if there is none
+    static bool find(const std::string& name, MaterialType& material);
+    
+    // Override materials from a definition file: one [Name] section per material (any but
+    // Empty), with any of
+    //   category = solid | liquid | powder | gas | other
+    //   flammable = yes | no,  passable = yes | no
+    //   density = kg/m^3,  color = r g b,  variation = r g b,  transparency = 0-255
+    //   inertia = 0-100,  dispersal = cells
+    //   reaction = neighbour, chance, product, neighbour product[, blast radius]
+    //   decay = percent, product,  lifetime = 0-255 updates
+    // The neighbour of a reaction is a material name or 'flammable' (any flammable material).
+    // A section's first reaction line replaces the material's reactions, later ones add to
+    // them, up to MaterialTables::MAX_REACTIONS; 'reaction = none' clears them. A decaying
+    // material turns into its product on the percent roll of each update, or once a cell has
+    // been updated 'lifetime' times; lifetime 0 leaves only the roll, and a lifetime without a
+    // decay does nothing.
+    // Fields and materials the file leaves out keep their current values. On an error the
+    // tables are left untouched and false is returned. Use World::loadMaterials() while a
+    // game is set up: it also rebuilds the simulation's lookup tables.
+    static bool loadDefinitions(const std::string& path);
+    
+private:
+    static inline MaterialTables s_tables = BUILTIN_MATERIAL_TABLES;
+};
+
+} // namespace PixelPhys
@@ -58,6 +58,7 @@ struct MaterialProperties {
     bool isGas;           // Rises upward
     bool isFlammable;     // Can catch fire
     bool isPassable;      // Player can pass through this material (non-colliding)
+    uint16_t density;     // kg/m^3: powders and liquids sink through lighter liquids and gases
     
     // Base colors (RGB, each 0-255)
     uint8_t r, g, b;
@@ -77,46 +78,46 @@ struct MaterialProperties {
 
 // Define properties for each material type
 constexpr std::array<MaterialProperties, static_cast<std::size_t>(MaterialType::COUNT)> MATERIAL_PROPERTIES = {{
-    //                         Physical Properties                    Base Color        Color Variation     Material-specific
-    //                         solid  liquid powder gas  flam pass.   r    g    b    varR varG varB        inert. disp.
-    /* Empty */               {false, false, false, false, false, true,     0,   0,   0,   0,   0,   0,    50,    0},
-    /* Sand */                {false, false, true,  false, false, false,   225, 215, 125, 10,  10,  15,    30,    0},
-    /* Water */               {false, true,  false, false, false, false,   32,  128, 235, 13,  12,  20,    0,     5},
-    /* Stone */               {true,  false, false, false, false, false,   120, 120, 125, 15,  15,  15,    90,    0},
-    /* Fire */                {false, false, false, true,  false, true,    255, 127, 32,  30,  40,  30,    0,     0},
-    /* Oil */                 {false, true,  false, false, true,  false,   140, 120, 60,  20,  20,  10,    0,     4},
-    /* GrassStalks */         {false, false, false, false, true,  true,    70,  200, 55,  10,  20,  10,    50,    0},
-    /* Dirt */                {true,  false, false, false, false, false,   110, 80,  40,  15,  10,  5,     70,    0},
-    /* FlammableGas */        {false, false, false, true,  true,  true,    50,  180, 50,  20,  40,  20,    0,     0},
-    /* Grass */               {true,  false, false, false, true,  false,   60,  180, 60,  15,  20,  10,    70,    0},
-    /* Lava */                {false, true,  false, false, false, false,   255, 80,  0,   30,  20,  10,    0,     2},
-    /* Snow */                {true,  false, false, false, false, false,   245, 245, 255, 5,   5,   5,     20,    0},
-    /* Bedrock */             {true,  false, false, false, false, false,   50,  50,  55,  10,  10,  10,    100,   0},
-    /* Sandstone */           {true,  false, false, false, false, false,   200, 180, 120, 15,  15,  10,    90,    0},
-    /* Gravel */              {false, false, true,  false, false, false,   130, 130, 130, 25,  25,  25,    50,    0},
-    /* TopSoil */             {true,  false, false, false, false, false,   80,  60,  40,  12,  10,  8,     70,    0},
-    /* DenseRock */           {true,  false, false, false, false, false,   90,  90,  100, 15,  15,  15,    100,   0},
+    //                         Physical Properties                                Base Color        Color Variation     Material-specific
+    //                         solid  liquid powder gas  flam pass.     density    r    g    b    varR varG varB        inert. disp.
+    /* Empty */               {false, false, false, false, false, true,       1,   0,   0,   0,   0,   0,   0,    50,    0},
+    /* Sand */                {false, false, true,  false, false, false,   1600,   225, 215, 125, 10,  10,  15,    30,    0},
+    /* Water */               {false, true,  false, false, false, false,   1000,   32,  128, 235, 13,  12,  20,    0,     5},
+    /* Stone */               {true,  false, false, false, false, false,   2600,   120, 120, 125, 15,  15,  15,    90,    0},
+    /* Fire */                {false, false, false, true,  false, true,       1,   255, 127, 32,  30,  40,  30,    0,     0},
+    /* Oil */                 {false, true,  false, false, true,  false,    900,   140, 120, 60,  20,  20,  10,    0,     4},
+    /* GrassStalks */         {false, false, false, false, true,  true,     300,   70,  200, 55,  10,  20,  10,    50,    0},
+    /* Dirt */                {true,  false, false, false, false, false,   1300,   110, 80,  40,  15,  10,  5,     70,    0},
+    /* FlammableGas */        {false, false, false, true,  true,  true,       1,   50,  180, 50,  20,  40,  20,    0,     0},
+    /* Grass */               {true,  false, false, false, true,  false,    400,   60,  180, 60,  15,  20,  10,    70,    0},
+    /* Lava */                {false, true,  false, false, false, false,   3100,   255, 80,  0,   30,  20,  10,    0,     2},
+    /* Snow */                {true,  false, false, false, false, false,    300,   245, 245, 255, 5,   5,   5,     20,    0},
+    /* Bedrock */             {true,  false, false, false, false, false,   3000,   50,  50,  55,  10,  10,  10,    100,   0},
+    /* Sandstone */           {true,  false, false, false, false, false,   2300,   200, 180, 120, 15,  15,  10,    90,    0},
+    /* Gravel */              {false, false, true,  false, false, false,   1800,   130, 130, 130, 25,  25,  25,    50,    0},
+    /* TopSoil */             {true,  false, false, false, false, false,   1200,   80,  60,  40,  12,  10,  8,     70,    0},
+    /* DenseRock */           {true,  false, false, false, false, false,   3000,   90,  90,  100, 15,  15,  15,    100,   0},
     
     // Ore materials - all are solid blocks with distinctive colors and variations
-    /* IronOre */             {true,  false, false, false, false, false,   120, 120, 130, 25,  20,  20,    100,   0},
-    /* CopperOre */           {true,  false, false, false, false, false,   180, 110, 70,  30,  15,  10,    100,   0},
-    /* GoldOre */             {true,  false, false, false, false, false,   220, 190, 50,  25,  25,  15,    100,   0},
-    /* CoalOre */             {true,  false, false, false, true,  false,   50,  50,  50,  10,  10,  10,    80,    0},
-    /* DiamondOre */          {true,  false, false, false, false, false,   140, 230, 240, 25,  35,  35,    100,   0},
-    /* SilverOre */           {true,  false, false, false, false, false,   200, 200, 210, 20,  20,  25,    100,   0},
-    /* EmeraldOre */          {true,  false, false, false, false, false,   40,  200, 90,  15,  30,  20,    100,   0},
-    /* SapphireOre */         {true,  false, false, false, false, false,   30,  90,  210, 15,  25,  40,    100,   0},
-    /* RubyOre */             {true,  false, false, false, false, false,   200, 30,  60,  40,  15,  20,    100,   0},
-    /* SulfurOre */           {true,  false, false, false, true,  false,   230, 220, 40,  35,  35,  15,    90,    0},
-    /* QuartzOre */           {true,  false, false, false, false, false,   235, 235, 235, 20,  20,  25,    100,   0},
-    /* UraniumOre */          {true,  false, false, false, false, false,   80,  170, 80,  30,  40,  20,    100,   0},
+    /* IronOre */             {true,  false, false, false, false, false,   5000,   120, 120, 130, 25,  20,  20,    100,   0},
+    /* CopperOre */           {true,  false, false, false, false, false,   4500,   180, 110, 70,  30,  15,  10,    100,   0},
+    /* GoldOre */             {true,  false, false, false, false, false,   6000,   220, 190, 50,  25,  25,  15,    100,   0},
+    /* CoalOre */             {true,  false, false, false, true,  false,   1400,   50,  50,  50,  10,  10,  10,    80,    0},
+    /* DiamondOre */          {true,  false, false, false, false, false,   3500,   140, 230, 240, 25,  35,  35,    100,   0},
+    /* SilverOre */           {true,  false, false, false, false, false,   5000,   200, 200, 210, 20,  20,  25,    100,   0},
+    /* EmeraldOre */          {true,  false, false, false, false, false,   2700,   40,  200, 90,  15,  30,  20,    100,   0},
+    /* SapphireOre */         {true,  false, false, false, false, false,   4000,   30,  90,  210, 15,  25,  40,    100,   0},
+    /* RubyOre */             {true,  false, false, false, false, false,   4000,   200, 30,  60,  40,  15,  20,    100,   0},
+    /* SulfurOre */           {true,  false, false, false, true,  false,   2000,   230, 220, 40,  35,  35,  15,    90,    0},
+    /* QuartzOre */           {true,  false, false, false, false, false,   2650,   235, 235, 235, 20,  20,  25,    100,   0},
+    /* UraniumOre */          {true,  false, false, false, false, false,   8000,   80,  170, 80,  30,  40,  20,    100,   0},
     
     // Worm/organic material properties
-    /* WormSkin */            {true,  false, false, false, true,  false,    40, 35,  30,  10,  10,  10,    40,    0}, // Black body
-    /* WormArmor */           {true,  false, false, false, false, false,    55, 50,  45,  10,  10,   8,    80,    0}, // Dark armor
-    /* WormHead */            {true,  false, false, false, false, false,    80, 70,  60,  15,  10,   8,    95,    0}, // Brown head
-    /* WormBlood */           {false, true,  false, false, false, false,   150, 10,  10,  10,   5,   5,     0,     3}, // Red blood
-    /* WormMouth */           {true,  false, false, false, false, false,   180, 30,  20,  15,   8,   5,    90,    0}  // Reddish mouth
+    /* WormSkin */            {true,  false, false, false, true,  false,   1100,   40, 35,  30,  10,  10,  10,    40,    0}, // Black body
+    /* WormArmor */           {true,  false, false, false, false, false,   1500,   55, 50,  45,  10,  10,   8,    80,    0}, // Dark armor
+    /* WormHead */            {true,  false, false, false, false, false,   1200,   80, 70,  60,  15,  10,   8,    95,    0}, // Brown head
+    /* WormBlood */           {false, true,  false, false, false, false,   1060,   150, 10,  10,  10,   5,   5,     0,     3}, // Red blood
+    /* WormMouth */           {true,  false, false, false, false, false,   1100,   180, 30,  20,  15,   8,   5,    90,    0}  // Reddish mouth
 }};
 
 } // namespace PixelPhys
\ No newline at end of file
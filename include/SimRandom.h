@@ -0,0 +1,31 @@
+#pragma once
+
+#include <cstdint>
+
+namespace PixelPhys {
+
+// Stateless random numbers for the simulation. Every draw is a hash of
+// (seed, tick, x, y, salt), so the result does not depend on the order in which chunks or
+// cells are updated, and a run replays exactly from the same seed on any thread count.
+namespace SimRandom {
+    // SplitMix64 finalizer
+    constexpr uint64_t mix(uint64_t z) {
+        z = (z ^ (z >> 30)) * 0xBF58476D1CE4E5B9ull;
+        z = (z ^ (z >> 27)) * 0x94D049BB133111EBull;
+        return z ^ (z >> 31);
+    }
+
+    // Random bits for one draw. Use a different salt for each independent draw made for
+    // the same cell in the same tick.
+    constexpr uint64_t hash(uint64_t seed, uint32_t tick, int x, int y, uint32_t salt) {
+        uint64_t h = mix(seed + 0x9E3779B97F4A7C15ull * ((uint64_t(tick) << 32) | salt));
+        return mix(h ^ ((uint64_t(static_cast<uint32_t>(y)) << 32) | static_cast<uint32_t>(x)));
+    }
+
+    // Seed of the chunk at the given world position
+    constexpr uint64_t chunkSeed(uint64_t worldSeed, int posX, int posY) {
+        return mix(worldSeed ^ mix((uint64_t(static_cast<uint32_t>(posY)) << 32) | static_cast<uint32_t>(posX)));
+    }
+}
+
+} // namespace PixelPhys
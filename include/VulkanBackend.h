@@ -3,6 +3,7 @@
 #include "RenderBackend.h"
 #include "RenderResources.h"
 #include "Materials.h"
+#include "MaterialRegistry.h"
 #include <memory>
 #include <string>
 #include <vector>
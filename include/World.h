@@ -1,6 +1,10 @@
 #pragma once
 
 #include "Materials.h"
+#include "MaterialRegistry.h"
+#include "MaterialPalette.h"
+#include "PhysicsConstants.h"
+#include "SimRandom.h"
 #include <vector>
 #include <memory>
 #include <random>
@@ -10,6 +14,10 @@
 #include <unordered_map>
 #include <unordered_set>
 #include <algorithm> // for std::find, std::sort
+#include <array>
+#include <atomic>
+#include <climits>
+#include "ChunkScheduler.h"
 
 namespace PixelPhys {
 
@@ -43,6 +51,138 @@ struct ChunkCoordHash {
 class Chunk;
 class ChunkManager;
 
+// Inclusive cell bounds of the part of a chunk that still needs simulating
+struct DirtyRect {
+    int minX = 0;
+    int minY = 0;
+    int maxX = -1;
+    int maxY = -1;
+    
+    bool isEmpty() const { return minX > maxX || minY > maxY; }
+    
+    void reset() {
+        minX = minY = 0;
+        maxX = maxY = -1;
+    }
+    
+    // Grow the rect so it contains the given cell
+    void include(int x, int y) {
+        if (isEmpty()) {
+            minX = maxX = x;
+            minY = maxY = y;
+            return;
+        }
+        minX = std::min(minX, x);
+        minY = std::min(minY, y);
+        maxX = std::max(maxX, x);
+        maxY = std::max(maxY, y);
+    }
+    
+    // Grow the rect so it contains another rect
+    void include(const DirtyRect& other) {
+        if (other.isEmpty()) return;
+        include(other.minX, other.minY);
+        include(other.maxX, other.maxY);
+    }
+    
+    int area() const { return isEmpty() ? 0 : (maxX - minX + 1) * (maxY - minY + 1); }
+};
+
+// DirtyRect that several simulation threads may grow at once. Chunks updated in the same
+// scheduler phase can both write into a shared neighbour through Chunk::set, so the
+// bounds are widened with atomic min/max instead of plain stores. Empty while min > max.
+class AtomicDirtyRect {
+public:
+    AtomicDirtyRect() { reset(); }
+    
+    void reset() {
+        m_minX.store(INT_MAX, std::memory_order_relaxed);
+        m_minY.store(INT_MAX, std::memory_order_relaxed);
+        m_maxX.store(INT_MIN, std::memory_order_relaxed);
+        m_maxY.store(INT_MIN, std::memory_order_relaxed);
+    }
+    
+    bool isEmpty() const {
+        return m_minX.load(std::memory_order_relaxed) > m_maxX.load(std::memory_order_relaxed);
+    }
+    
+    // Grow the rect so it contains the given cell
+    void include(int x, int y) {
+        lowerTo(m_minX, x);
+        lowerTo(m_minY, y);
+        raiseTo(m_maxX, x);
+        raiseTo(m_maxY, y);
+    }
+    
+    // Snapshot of the current bounds (only consistent while no other thread is writing)
+    DirtyRect load() const {
+        DirtyRect rect;
+        if (!isEmpty()) {
+            rect.minX = m_minX.load(std::memory_order_relaxed);
+            rect.minY = m_minY.load(std::memory_order_relaxed);
+            rect.maxX = m_maxX.load(std::memory_order_relaxed);
+            rect.maxY = m_maxY.load(std::memory_order_relaxed);
+        }
+        return rect;
+    }
+    
+private:
+    std::atomic<int> m_minX;
+    std::atomic<int> m_minY;
+    std::atomic<int> m_maxX;
+    std::atomic<int> m_maxY;
+    
+    static void lowerTo(std::atomic<int>& bound, int value) {
+        int current = bound.load(std::memory_order_relaxed);
+        while (value < current && !bound.compare_exchange_weak(current, value, std::memory_order_relaxed)) {}
+    }
+    
+    static void raiseTo(std::atomic<int>& bound, int value) {
+        int current = bound.load(std::memory_order_relaxed);
+        while (value > current && !bound.compare_exchange_weak(current, value, std::memory_order_relaxed)) {}
+    }
+};
+
+// Packed simulation state of one cell. Everything a pass needs for a cell sits in these
+// 4 bytes, so neighbouring cells share cache lines instead of living in separate arrays.
+struct Cell {
+    static constexpr uint8_t MAX_MOVE_STAMP = 127;
+    
+    MaterialType material;
+    uint8_t freeFalling : 1;  // Powder is in motion (settled grains may be knocked loose)
+    uint8_t moveStamp : 7;    // Stamp of the pass that last moved the cell (see Chunk::advanceMoveStamps)
+    int8_t velocity;          // Downward speed in cells per update, up to Physics::MAX_FALL_SPEED
+    uint8_t life;             // Remaining lifetime in updates (starts at MaterialTables::lifetime)
+    
+    Cell() : material(MaterialType::Empty), freeFalling(0), moveStamp(0), velocity(0), life(0) {}
+    
+    explicit Cell(MaterialType type)
+        : material(type), freeFalling(0), moveStamp(0), velocity(0),
+          life(MaterialRegistry::tables().lifetime[static_cast<std::size_t>(type)]) {}
+};
+static_assert(sizeof(Cell) == 4, "Cell should stay packed into 4 bytes");
+static_assert(Physics::FIRE_LIFETIME <= 255, "fire lifetime must fit in Cell::life");
+
+// Read-only window onto a rectangle of one chunk's cells, for reading without a lookup per
+// cell. The cells of a row are contiguous and rows are 'stride' cells apart; x and y are the
+// world position of the top-left cell.
+struct ChunkView {
+    const Cell* cells = nullptr;   // Top-left cell (nullptr where no chunk is loaded)
+    int stride = 0;
+    int x = 0;
+    int y = 0;
+    int width = 0;
+    int height = 0;
+    
+    bool contains(int worldX, int worldY) const {
+        return worldX >= x && worldX < x + width && worldY >= y && worldY < y + height;
+    }
+    
+    // First cell (column x) of world row worldY
+    const Cell* row(int worldY) const { return cells + (worldY - y) * stride; }
+    const Cell& at(int worldX, int worldY) const { return row(worldY)[worldX - x]; }
+};
+
 // A chunk is a fixed-size part of the world
 // Using a chunk-based approach allows easier multithreading and memory management
 class Chunk {
@@ -51,6 +191,13 @@ public:
     static constexpr int WIDTH = 512;   // Slightly larger chunks for more coherent ore patterns
     static constexpr int HEIGHT = 512;
     
+    // Activity is tracked per 64x64 tile: an 8x8 bitmap per chunk, one bit per tile
+    static constexpr int TILE_SIZE = 64;
+    static constexpr int TILES_X = WIDTH / TILE_SIZE;
+    static constexpr int TILES_Y = HEIGHT / TILE_SIZE;
+    static constexpr uint64_t ALL_TILES = ~uint64_t(0);
+    static_assert(TILES_X * TILES_Y == 64, "tile bitmap must fit in 64 bits");
+    
     Chunk(int posX = 0, int posY = 0);
     ~Chunk() = default;
     
@@ -64,84 +211,464 @@ public:
     // Set material at the given position within this chunk
     void set(int x, int y, MaterialType material);
     
-    // Update physics for this chunk (will be called every frame)
-    // Needs access to surrounding chunks for proper boundary physics
-    void update(Chunk* chunkBelow, Chunk* chunkLeft, Chunk* chunkRight);
+    // Read-only view of the whole chunk, or of a chunk-local rectangle inside it
+    ChunkView view() const { return view(0, 0, WIDTH, HEIGHT); }
+    ChunkView view(int x, int y, int width, int height) const {
+        return {&m_cells[cellIndex(x, y)], STRIDE, m_posX + x, m_posY + y, width, height};
+    }
+    
+    // Raw write view for bulk edits. Writes go straight into the cell grid as fresh cells of
+    // their material; the run-start bits and the wake-up of everything edited (plus a one-cell
+    // border) happen once, in commit() or when the editor goes out of scope. Like set(), it
+    // must not be used while the chunk is being updated. Coordinates are chunk-local.
+    class Editor {
+    public:
+        explicit Editor(Chunk& chunk) : m_chunk(chunk) {}
+        ~Editor() { commit(); }
+        
+        Editor(const Editor&) = delete;
+        Editor& operator=(const Editor&) = delete;
+        
+        MaterialType get(int x, int y) const { return m_chunk.m_cells[cellIndex(x, y)].material; }
+        
+        // Write one cell (skipped if it already holds the material)
+        void set(int x, int y, MaterialType material);
+        
+        // Overwrite columns x0..x1 of row y, clamped to the chunk
+        void fillSpan(int x0, int x1, int y, MaterialType material);
+        
+        // Refresh the run-start bits of the edited area and wake it for the next update
+        void commit();
+        
+    private:
+        Chunk& m_chunk;
+        DirtyRect m_edited;
+    };
+    
+    // Update physics for this chunk (will be called every frame). The neighbours fill the
+    // halo before the passes run and receive whatever the passes moved into it.
+    void update(const ChunkNeighbors& neighbors);
+    
+    // Implementations of the powder pass, switchable for A/B comparisons. Both are deterministic
+    // but they do not take the same steps. The scalar sweep moves grains one at a time, right
+    // to left, so a blocked grain sliding down-left can take the cell below its left neighbour
+    // before that neighbour falls into it. A landing column therefore shears to the left and
+    // spreads fast. The bitboard kernel settles every straight fall of a row before any slide,
+    // so the pile stays centred and erodes from its top corners. A dropped column takes longer
+    // to come to rest that way (the SDLK_t column: 1030 updates against 615, see the bench).
+    enum class PowderKernel {
+        Scalar,     // Cell-by-cell sweep
+        Bitboard    // 64 cells per step using row occupancy bitmasks
+    };
+    static void setPowderKernel(PowderKernel kernel) { s_powderKernel = kernel; }
+    static PowderKernel getPowderKernel() { return s_powderKernel; }
+    
+    // An update that runs only the powder pass, with the current kernel: no halo exchange, no
+    // other material classes and no recolour. For timing the kernels on their own; the
+    // simulation always goes through update().
+    void updatePowders();
+    
+    // How Chunk::update walks the dirty rect, switchable for A/B comparisons
+    enum class UpdateMode {
+        MultiPass,  // Separate sweeps for powders, liquid falls, spreading, gases and reactions
+        Fused       // One bottom-up sweep that runs all of them row by row
+    };
+    static void setUpdateMode(UpdateMode mode) { s_updateMode = mode; }
+    static UpdateMode getUpdateMode() { return s_updateMode; }
+    
+    // Rebuild the update's lookup tables (movement classes, displacement, reactions) from
+    // MaterialRegistry::tables(). Not thread-safe: call it while no chunk is updating.
+    static void rebuildMaterialTables();
     
     // Check if this chunk needs updating (has active materials)
-    bool isDirty() const { return m_isDirty; }
+    bool isDirty() const { return m_isDirty.load(std::memory_order_relaxed); }
     
     // Mark this chunk as needing update
-    void setDirty(bool dirty) { m_isDirty = dirty; }
+    void setDirty(bool dirty) { m_isDirty.store(dirty, std::memory_order_relaxed); }
     
     // Check if this chunk needs updating next frame
-    bool shouldUpdateNextFrame() const { return m_shouldUpdateNextFrame; }
+    bool shouldUpdateNextFrame() const { return m_shouldUpdateNextFrame.load(std::memory_order_relaxed); }
     
     // Mark this chunk for update next frame
-    void setShouldUpdateNextFrame(bool update) { m_shouldUpdateNextFrame = update; }
+    void setShouldUpdateNextFrame(bool update) { m_shouldUpdateNextFrame.store(update, std::memory_order_relaxed); }
     
     // Get inactivity counter
     int getInactivityCounter() const { return m_inactivityCounter; }
     
-    // Set free falling state for a specific cell
-    void setFreeFalling(int idx, bool falling) { 
-        if (idx >= 0 && idx < static_cast<int>(m_isFreeFalling.size())) {
-            m_isFreeFalling[idx] = falling; 
-        }
-    }
+    // Seed the chunk's random draws from the world seed (mixed with the chunk position)
+    void setRandomSeed(uint64_t worldSeed) { m_randomSeed = SimRandom::chunkSeed(worldSeed, m_posX, m_posY); }
+    
+    // Force the whole chunk to be simulated next update (after loading, levelling, etc.)
+    void markAllDirty();
+    
+    // Region simulated by the most recent update and the region queued for the next one
+    const DirtyRect& getDirtyRect() const { return m_dirtyRect; }
+    DirtyRect getNextDirtyRect() const { return m_nextDirtyRect.load(); }
+    
+    // Tiles simulated by the most recent update and tiles woken for the next one
+    // (bit tileY * TILES_X + tileX)
+    uint64_t getAwakeTiles() const { return m_awakeTiles; }
+    uint64_t getNextAwakeTiles() const { return m_nextAwakeTiles.load(std::memory_order_relaxed); }
+    
+    // Wake a whole tile for the next update
+    void wakeTile(int tileX, int tileY);
+    
+    // Quick rest state for chunks too far away to simulate: decaying materials turn into what
+    // they decay into (fire burns out), powders and liquids drop straight down their columns
+    // onto whatever holds them, sinking through lighter liquids and gases, and gases rise to
+    // the top of theirs, in one pass. The chunk's edges count as walls.
+    // Leaves the chunk asleep; returns whether anything moved.
+    bool settle();
     
     // Get raw pixel data for rendering
     uint8_t* getPixelData() { return m_pixelData.data(); }
     
-    // Update rendering pixel data based on materials
+    // Recolour every cell of the chunk
     void updatePixelData();
     
+    // Recolour only the cells written since the last call: every write (moves, reactions,
+    // edits, cells handed over by a neighbour) marks its row of its tile, so the work
+    // follows what changed rather than what was scanned
+    void updateChangedPixels();
+    
+    // Append the pixels recoloured since the last call to 'spans' (chunk-local cells), then
+    // forget them. A span is a run of consecutive changed rows of a tile, widened over the
+    // neighbouring tiles that changed the same rows. For copying or uploading only the
+    // pixels that changed.
+    void takePixelChanges(std::vector<DirtyRect>& spans);
+    
     // Serialization methods for streaming system (will be implemented later)
     bool serialize(std::ostream& out) const;
     bool deserialize(std::istream& in);
     
     // Check if the chunk has been modified since last save
-    bool isModified() const { return m_isModified; }
+    bool isModified() const { return m_isModified.load(std::memory_order_relaxed); }
     
     // Set modified flag
-    void setModified(bool modified) { m_isModified = modified; }
+    void setModified(bool modified) { m_isModified.store(modified, std::memory_order_relaxed); }
     
 private:
-    // Grid of materials in the chunk
-    std::vector<MaterialType> m_grid;
+    // Grid of cells in the chunk (material plus per-cell simulation state), surrounded by a
+    // one-cell halo: rows -1 and HEIGHT and columns -1 and WIDTH mirror the neighbouring
+    // chunks during an update, so the passes never need a chunk-boundary branch
+    std::vector<Cell> m_cells;
+    static constexpr int STRIDE = WIDTH + 2;
+    static constexpr int HALO_CELLS = 2 * STRIDE + 2 * HEIGHT;
+    
+    // Index of cell (x, y) in m_cells, valid for -1 <= x <= WIDTH and -1 <= y <= HEIGHT
+    static int cellIndex(int x, int y) { return (y + 1) * STRIDE + (x + 1); }
+    
+    // Halo cells without a neighbouring chunk hold this wall
+    static constexpr MaterialType HALO_WALL = MaterialType::Bedrock;
+    
+    // Halo contents right after syncHalo(), to find the cells the passes changed
+    std::vector<Cell> m_haloSnapshot;
+    
+    // Call f(i, x, y) for every halo cell, i counting 0..HALO_CELLS-1
+    template <typename F>
+    static void forEachHaloCell(F&& f) {
+        int i = 0;
+        for (int x = -1; x <= WIDTH; ++x) f(i++, x, -1);
+        for (int x = -1; x <= WIDTH; ++x) f(i++, x, HEIGHT);
+        for (int y = 0; y < HEIGHT; ++y) f(i++, -1, y);
+        for (int y = 0; y < HEIGHT; ++y) f(i++, WIDTH, y);
+    }
+    
+    // settle() for the cells of column x from row top down to row bottom, with no static
+    // cell among them. The vectors are scratch space. Returns whether anything moved.
+    bool settleSpan(int x, int top, int bottom, std::vector<Cell>& sunk, std::vector<Cell>& risen);
+    
+    // Copy the neighbours' edge cells into the halo (walls where there is no neighbour)
+    void syncHalo(const ChunkNeighbors& neighbors);
+    
+    // Write the halo cells the passes changed back into the neighbours and wake the
+    // neighbours' cells next to our own activity
+    void flushHalo(const ChunkNeighbors& neighbors);
+    
+    // Take a cell from a neighbour's halo flush and queue it for simulation. 'drift' marks a
+    // cell that only slid along a settled liquid surface (see markCellDirty).
+    void receiveHaloCell(int x, int y, const Cell& cell, bool drift);
+    
+    // Wake the cells of a rectangle (clamped to the chunk) for the next update
+    void wakeRect(int x0, int y0, int x1, int y1, bool drift = false);
+    
+    // Version tag of the per-cell state block written after the materials by serialize()
+    static constexpr uint32_t CELL_STATE_VERSION = 1;
     
     // For rendering: RGBA pixel data (r,g,b,a for each cell)
     std::vector<uint8_t> m_pixelData;
     
+    // Flags written by neighbouring chunks are atomic: the scheduler may run two of them
+    // on different threads while both push cells into this chunk
+    
     // Flag to track if this chunk has been modified since last save
-    bool m_isModified = false;
+    std::atomic<bool> m_isModified{false};
     
     // Flag to indicate if this chunk needs updating this frame
-    bool m_isDirty;
+    std::atomic<bool> m_isDirty;
     
     // Flag to indicate if this chunk should be updated next frame
-    bool m_shouldUpdateNextFrame;
+    std::atomic<bool> m_shouldUpdateNextFrame;
     
     // Counter to track how many frames a chunk has been inactive
     int m_inactivityCounter;
     
+    // Cells the current update is allowed to scan, and cells touched since it started.
+    // Every pass in update() only iterates m_dirtyRect; moves and writes grow m_nextDirtyRect.
+    DirtyRect m_dirtyRect;
+    AtomicDirtyRect m_nextDirtyRect;
+    
+    // Awake tiles for the current update and tiles woken since it started. Inside the
+    // dirty rect, passes skip every cell whose tile is asleep. Neighbours may wake tiles
+    // from other threads, hence the atomic.
+    uint64_t m_awakeTiles = 0;
+    std::atomic<uint64_t> m_nextAwakeTiles{0};
+    
+    // Tiles woken since the current update started by a real change: anything except a
+    // liquid drifting along a flat surface. A settled lake keeps shuffling its top row back
+    // and forth forever, so a tile that sees nothing but drift for TILE_SLEEP_UPDATES updates
+    // in a row falls asleep, and stays asleep until a real change next to its cells.
+    std::atomic<uint64_t> m_nextRestlessTiles{0};
+    static constexpr int TILE_SLEEP_UPDATES = 32;
+    std::array<uint8_t, TILES_X * TILES_Y> m_tileCalmUpdates{};
+    
+    // Rows of each tile with cells written since the last recolour (bit y % TILE_SIZE), and
+    // rows recoloured since the last takePixelChanges(). Plain words: within an update only
+    // this chunk writes its own cells, and the neighbours of one phase that hand cells over
+    // write edge cells of different tiles (see receiveHaloCell).
+    static_assert(TILE_SIZE == 64, "one bit per row of a tile");
+    std::array<uint64_t, TILES_X * TILES_Y> m_changedPixelRows{};
+    std::array<uint64_t, TILES_X * TILES_Y> m_recoloredRows{};
+    
+    void markPixelChanged(int x, int y) {
+        m_changedPixelRows[(y / TILE_SIZE) * TILES_X + x / TILE_SIZE] |= uint64_t(1) << (y % TILE_SIZE);
+    }
+    
+    // Mark row y of every tile the span [x0, x1] overlaps
+    void markPixelsChanged(int x0, int y, int x1);
+    
+    // Count the calm updates of the woken tiles and return them without the ones that sleep
+    uint64_t dropSleepingTiles(uint64_t woken, uint64_t restless);
+    
+    // Bit of the tile that holds a cell
+    static uint64_t tileBit(int x, int y) {
+        return uint64_t(1) << ((y / TILE_SIZE) * TILES_X + x / TILE_SIZE);
+    }
+    
+    // Awake tiles of the tile row that holds cell row y, one bit per tile column
+    static uint32_t tileRowMask(uint64_t tiles, int y) {
+        return static_cast<uint32_t>(tiles >> ((y / TILE_SIZE) * TILES_X)) & ((1u << TILES_X) - 1);
+    }
+    
+    static bool isTileAwake(uint32_t rowMask, int x) {
+        return (rowMask >> (x / TILE_SIZE)) & 1u;
+    }
+    
+    // Queue a changed cell and its direct neighbours for the next update. The
+    // neighbourhood only reaches into another tile when the cell sits on a tile edge.
+    // Drift (a surface liquid cell sliding sideways) wakes the tiles without resetting
+    // their sleep countdown.
+    void markCellDirty(int x, int y, bool drift = false) {
+        DirtyRect rect;
+        uint64_t tiles = 0;
+        addCellNeighbourhood(x, y, rect, tiles);
+        markDirty(rect, tiles, drift);
+    }
+    
+    // Grow a rect and a tile set by what markCellDirty(x, y) queues, for callers that mark
+    // many cells and then queue them all with one markDirty()
+    static void addCellNeighbourhood(int x, int y, DirtyRect& rect, uint64_t& tiles) {
+        int x0 = std::max(0, x - 1);
+        int y0 = std::max(0, y - 1);
+        int x1 = std::min(WIDTH - 1, x + 1);
+        int y1 = std::min(HEIGHT - 1, y + 1);
+        rect.include(x0, y0);
+        rect.include(x1, y1);
+        tiles |= tileBit(x0, y0) | tileBit(x1, y0) | tileBit(x0, y1) | tileBit(x1, y1);
+    }
+    
+    void markDirty(const DirtyRect& rect, uint64_t tiles, bool drift = false) {
+        if (rect.isEmpty()) {
+            return;
+        }
+        m_nextDirtyRect.include(rect.minX, rect.minY);
+        m_nextDirtyRect.include(rect.maxX, rect.maxY);
+        if ((m_nextAwakeTiles.load(std::memory_order_relaxed) & tiles) != tiles) {
+            m_nextAwakeTiles.fetch_or(tiles, std::memory_order_relaxed);
+        }
+        if (!drift && (m_nextRestlessTiles.load(std::memory_order_relaxed) & tiles) != tiles) {
+            m_nextRestlessTiles.fetch_or(tiles, std::memory_order_relaxed);
+        }
+    }
+    
+    // Powder pass used by every chunk (set before the simulation starts)
+    static inline PowderKernel s_powderKernel = PowderKernel::Bitboard;
+    
+    // Update walk used by every chunk (set before the simulation starts)
+    static inline UpdateMode s_updateMode = UpdateMode::Fused;
+    
+    // Start of an update: take the queued dirty rect and awake tiles. Returns false when
+    // there is nothing to simulate.
+    bool beginUpdate();
+    
+    // The powder pass of the multi-pass update, with the selected kernel
+    void updatePowderPass(bool& anyMaterialMoved);
+    
+    // Multi-pass update: one sweep over the dirty rect per step. The single-class sweeps are
+    // one template over a policy per material class (defined in World.cpp) that sets the
+    // class, the sweep order and the step, so each gets its own specialised loop.
+    struct PowderPolicy;
+    struct LiquidFallPolicy;
+    struct GasPolicy;
+    template <typename Policy>
+    void sweepCells(bool& anyMaterialMoved);
+    void updatePowdersBitboard(bool& anyMaterialMoved);
+    void updateLiquidSpreading(bool& anyMaterialMoved);
+    
     // Handle interactions between different materials (fire spreading, etc.)
-    void handleMaterialInteractions(const std::vector<MaterialType>& oldGrid, bool& anyMaterialMoved);
+    void handleMaterialInteractions(bool& anyMaterialMoved);
+    
+    // Fused update: a single bottom-up sweep, gases and reactions trailing a few rows behind
+    void updateFused(bool& anyMaterialMoved);
+    void riseGasRowFused(int y, bool& anyMaterialMoved);
+    void reactRowFused(int y, bool& anyMaterialMoved);
+    
+    // Cells of one row for the bitboard powder kernel, one bit per cell: the empty ones a grain
+    // falls into and the liquid and gas ones it may sink through
+    struct RowCells {
+        uint64_t empty[WIDTH / 64];
+        uint64_t fluid[WIDTH / 64];
+    };
+    
+    // Powder kernel for one row. 'below' holds the cells of row y + 1 when haveBelow is set;
+    // afterwards it holds those of row y. Returns false if the row is asleep.
+    bool updatePowderRowBitboard(int y, RowCells& below, bool haveBelow, bool& anyMaterialMoved);
+    
+    // Per-cell steps shared by both update modes
+    void stepPowder(int x, int y, bool& anyMaterialMoved);
+    void stepLiquidFall(int x, int y, bool& anyMaterialMoved);
+    void stepLiquidSpread(int x, int y, bool leftToRight, bool& anyMaterialMoved);
+    bool stepGas(int x, int y, bool& anyMaterialMoved);   // Returns true if the gas moved
+    
+    // Reactions: one kernel for every material, driven by the reaction matrix in World.cpp.
+    // Cells without any reaction (empty, stone, ores...) are rejected by one table lookup.
+    static std::array<bool, static_cast<std::size_t>(MaterialType::COUNT)> s_reactiveMaterials;
+    static bool isReactive(MaterialType material) { return s_reactiveMaterials[static_cast<std::size_t>(material)]; }
+    void applyReactions(int x, int y, bool& anyMaterialMoved);
+    void reactCell(int x, int y, bool& anyMaterialMoved) {
+        if (isReactive(m_cells[cellIndex(x, y)].material)) {
+            applyReactions(x, y, anyMaterialMoved);
+        }
+    }
+    
+    // Cells (halo included) whose material reacts. Chunks without any skip the reaction sweep.
+    // Neighbours of one scheduler phase hand over halo cells concurrently, hence atomic.
+    std::atomic<int> m_reactiveCells{0};
+    void trackReactive(MaterialType before, MaterialType after) {
+        const int change = int(isReactive(after)) - int(isReactive(before));
+        if (change != 0) {
+            m_reactiveCells.fetch_add(change, std::memory_order_relaxed);
+        }
+    }
+    void recountReactiveCells();
+    
+    // Rows a cell at (x, y) falls this update at the given speed: the run of empty cells
+    // straight below it, at least one (the caller checked the cell below) and at most 'speed'
+    int fallDistance(int idx, int y, int speed) const;
     
     // Helper to count water pixels below current position (for depth-based effects)
     int countWaterBelow(int x, int y) const;
     
-    // For random number generation in material interactions
-    std::mt19937 m_rng{std::random_device{}()};
-    
-    // Helper for determining if a material can fall into another material
-    bool canDisplace(MaterialType above, MaterialType below) const;
+    // Random draws of the simulation: a hash of the chunk seed, the update count, the cell and a
+    // per-draw salt. Same seed, same updates, same results - whatever thread runs the chunk.
+    uint64_t m_randomSeed = 0;
+    uint32_t m_tick = 0;
+    uint64_t random(int x, int y, uint32_t salt) const { return SimRandom::hash(m_randomSeed, m_tick, x, y, salt); }
     
     // Helpers for liquid dynamics
-    bool isNotIsolatedLiquid(const std::vector<MaterialType>& grid, int x, int y);
+    bool isNotIsolatedLiquid(int x, int y) const;
+    
+    // Column depth field for horizontal spreading. Bit y of a column is set where a run of one
+    // material starts: at row 0 and wherever a cell differs from the one above. The height of
+    // a liquid column above a cell is then the distance to the nearest run start at or above
+    // it, a lookup instead of a walk up the column. Only bits of liquid rows are kept exact.
+    // Every write refreshes two bits; the halo columns are rebuilt after each sync.
+    // Layout: (x + 1) * COLUMN_WORDS + y / 64.
+    static constexpr int COLUMN_WORDS = HEIGHT / 64;
+    static_assert(HEIGHT % 64 == 0, "run-start bitmaps need whole 64-row words per column");
+    std::vector<uint64_t> m_runStarts;
+    
+    // Recompute the run-start bit of cell (x, y), 0 <= y < HEIGHT, if it holds a liquid
+    void updateRunStart(int x, int y);
+    
+    // Bookkeeping for a cell whose contents changed: the run-start bits that depend on it
+    // (its own and the one below) and its pixel
+    void cellChanged(int idx);
+    
+    // Recompute every run-start bit of a column
+    void rebuildRunStarts(int x);
+    
+    // Number of cells of the same material from (x, y) up to the top of its run (or row 0)
+    int runHeight(int x, int y) const;
+    
+    // Replace a cell, keeping the depth field in sync
+    void writeCell(int idx, const Cell& cell) {
+        trackReactive(m_cells[idx].material, cell.material);
+        m_cells[idx] = cell;
+        cellChanged(idx);
+    }
     
-    // Track if an element is currently in motion (for sand inertia)
-    std::vector<bool> m_isFreeFalling;
+    // Cell::moveStamp values of the current update. Passes skip cells carrying this
+    // update's stamps, which replaces copying the grid on every update.
+    uint8_t m_fallStamp = 0;    // Powder, liquid-fall and gas moves
+    uint8_t m_spreadStamp = 0;  // Horizontal liquid spreading
+    
+    // Start a new update's pair of move stamps
+    void advanceMoveStamps();
+    
+    // Move a cell with all its state to another index of this chunk (halo included), leaving Empty behind
+    void moveCell(int from, int to, uint8_t stamp) {
+        trackReactive(m_cells[to].material, MaterialType::Empty);   // A displaced cell is lost
+        m_cells[to] = m_cells[from];
+        m_cells[to].moveStamp = stamp;
+        m_cells[from] = Cell();
+        cellChanged(to);
+        cellChanged(from);
+    }
+    
+    // Move a grain of the bitboard powder kernel from (x, y) into the empty cell (toX, toY),
+    // which may be in the halo, and mark it free-falling. Nothing is displaced and neither cell
+    // ends up liquid, so the only run-start bits to refresh are those of the cells below.
+    Cell& moveGrain(int x, int y, int toX, int toY) {
+        Cell& to = m_cells[cellIndex(toX, toY)];
+        Cell& from = m_cells[cellIndex(x, y)];
+        to = from;
+        to.moveStamp = m_fallStamp;
+        to.freeFalling = true;
+        from = Cell();
+        markPixelChanged(x, y);
+        if (y + 1 < HEIGHT) {
+            updateRunStart(x, y + 1);
+        }
+        if (toY < HEIGHT) {
+            if (toX >= 0 && toX < WIDTH) {
+                markPixelChanged(toX, toY);
+            }
+            if (toY + 1 < HEIGHT) {
+                updateRunStart(toX, toY + 1);
+            }
+        }
+        return to;
+    }
+    
+    // Trade two cells with all their state (halo included), as when one sinks through the other
+    void swapCells(int a, int b, uint8_t stamp) {
+        std::swap(m_cells[a], m_cells[b]);
+        m_cells[a].moveStamp = stamp;
+        m_cells[b].moveStamp = stamp;
+        cellChanged(a);
+        cellChanged(b);
+    }
 };
 
 // Chunk streaming system
@@ -155,9 +682,19 @@ public:
     void updateActiveChunks(int centerX, int centerY);
     void update();
     
+    // Chunk held in memory, loaded or cached (nullptr otherwise); never loads anything
+    Chunk* getResidentChunk(int chunkX, int chunkY);
+    
+    // Cached chunks in the ring around the active chunks, which keep simulating at a reduced
+    // rate. Cached chunks further out are settled to rest instead (see updateActiveChunks).
+    const std::vector<ChunkCoord>& getLodChunks() const { return m_lodChunks; }
+    
     // Save all modified chunks
     void saveAllModifiedChunks();
     
+    // World seed for the random draws of loaded and future chunks
+    void setRandomSeed(uint64_t worldSeed);
+    
     // Visibility checker
     bool isChunkVisible(int chunkX, int chunkY, int cameraX, int cameraY, int screenWidth, int screenHeight) const;
     
@@ -197,12 +734,19 @@ private:
     // Currently active chunk coordinates
     std::vector<ChunkCoord> m_activeChunks;
     
+    // Cached chunks within LOD_RING_RADIUS chunks (Chebyshev) of the player's chunk
+    static constexpr int LOD_RING_RADIUS = 3;
+    std::vector<ChunkCoord> m_lodChunks;
+    
     // Maximum number of chunks to keep loaded - matches Noita's approach in GDC talk
     const int MAX_LOADED_CHUNKS = 12; // Exactly 12 chunks as specified in the streaming design
     
     // Size of chunks in world units
     const int m_chunkSize;
     
+    // World seed handed to every chunk that gets loaded or created
+    uint64_t m_randomSeed = 0;
+    
     // Base folder for chunk storage
     std::string m_chunkStoragePath;
     
@@ -213,12 +757,67 @@ private:
     std::unique_ptr<Chunk> createNewChunk(const ChunkCoord& coord);
 };
 
+// Read-only view of a rectangle of the world: the ChunkViews of the chunks it overlaps, in
+// row-major chunk order. The views point straight into the chunks, so a RegionView is only
+// valid until the next update, edit or chunk load/unload - take a fresh one each time.
+class RegionView {
+public:
+    int getX() const { return m_x; }
+    int getY() const { return m_y; }
+    int getWidth() const { return m_width; }
+    int getHeight() const { return m_height; }
+    
+    // Windows covering the region, clipped to it (cells == nullptr for chunks not resident)
+    const std::vector<ChunkView>& getChunkViews() const { return m_views; }
+    
+    // Material at world coordinates: Empty outside the region and in chunks not resident.
+    // Queries landing in the same chunk as the previous one skip the chunk lookup.
+    MaterialType get(int x, int y) const {
+        if (m_last < 0 || !m_views[m_last].contains(x, y)) {
+            m_last = findView(x, y);
+            if (m_last < 0) {
+                return MaterialType::Empty;
+            }
+        }
+        return m_views[m_last].at(x, y).material;
+    }
+    
+private:
+    friend class World;
+    
+    // Index of the loaded view containing (x, y), or -1
+    int findView(int x, int y) const;
+    
+    int m_x = 0;
+    int m_y = 0;
+    int m_width = 0;
+    int m_height = 0;
+    
+    // Chunk coordinates of the first view and views per row of chunks
+    int m_firstChunkX = 0;
+    int m_firstChunkY = 0;
+    int m_chunksAcross = 0;
+    
+    std::vector<ChunkView> m_views;
+    mutable int m_last = -1;
+};
+
 // The World manages a collection of chunks that make up the entire simulation
 class World {
 public:
+    // advance() defaults: 30 ticks per second, catching up at most 4 ticks per call
+    static constexpr double DEFAULT_TICK_RATE = 30.0;
+    static constexpr int DEFAULT_MAX_TICKS_PER_ADVANCE = 4;
+    
     World(int width, int height);
     ~World() = default;
     
+    // Tune materials from a definition file (see MaterialRegistry::loadDefinitions) and
+    // rebuild the simulation tables and colour palette that derive from them. Call it before
+    // creating a World: chunks keep counts (reactive cells) that depend on the tables. On an
+    // error the current materials are kept and false is returned.
+    static bool loadMaterials(const std::string& path);
+    
     // Get world dimensions in pixels
     int getWidth() const { return m_width; }
     int getHeight() const { return m_height; }
@@ -233,15 +832,81 @@ public:
     MaterialType get(int x, int y) const;
     void set(int x, int y, MaterialType material);
     
+    // Read access to a rectangle (clipped to the world) straight from the resident chunks
+    RegionView view(int x, int y, int width, int height) const;
+    
+    // Bulk edits, clipped to the world. Each chunk touched is looked up once and written a
+    // row span at a time through a Chunk::Editor; colours follow with the chunk's next update.
+    void fillSpan(int x, int y, int length, MaterialType material);
+    void fillRect(int x, int y, int width, int height, MaterialType material);
+    
+    // Fill the cells within radius of the centre (dx*dx + dy*dy <= radius*radius)
+    void paintCircle(int centerX, int centerY, int radius, MaterialType material);
+    
+    // Rewrite a rectangle cell by cell: edit(x, y, current) returns the cell's new material
+    // (returning current leaves the cell untouched)
+    template <typename F>
+    void editRect(int x, int y, int width, int height, F&& edit) {
+        forEachChunkInRect(x, y, width, height, [&](Chunk::Editor& editor, int originX, int originY,
+                                                    int x0, int y0, int x1, int y1) {
+            for (int ly = y0; ly <= y1; ++ly) {
+                for (int lx = x0; lx <= x1; ++lx) {
+                    MaterialType current = editor.get(lx, ly);
+                    MaterialType material = edit(originX + lx, originY + ly, current);
+                    if (material != current) {
+                        editor.set(lx, ly, material);
+                    }
+                }
+            }
+        });
+    }
+    
     // Get material type for rendering with shader-based effects
     MaterialType getMaterialAt(int x, int y) const { return get(x, y); }
     
-    // Update the entire world's physics
+    // Run one simulation tick over the entire world
     void update();
     
+    // Fixed-timestep clock: banks dt seconds of real time and runs as many whole ticks as it
+    // covers, at most the catch-up cap per call (time beyond the cap is dropped so a slow
+    // frame cannot snowball). Returns the number of ticks run. Batch runs that want to go
+    // faster than real time can call update() directly.
+    int advance(double dt);
+    
+    // Simulation ticks per second of advance() time
+    void setTickRate(double ticksPerSecond);
+    double getTickRate() const { return m_tickRate; }
+    
+    // Most ticks a single advance() call may run to catch up
+    void setMaxTicksPerAdvance(int maxTicks) { m_maxTicksPerAdvance = std::max(1, maxTicks); }
+    int getMaxTicksPerAdvance() const { return m_maxTicksPerAdvance; }
+    
+    // Ticks simulated so far, and how far (0..1) the clock is between the last tick and the
+    // next one, for interpolating what is drawn
+    uint32_t getTickCount() const { return m_tick; }
+    double getInterpolationAlpha() const { return m_tickAccumulator * m_tickRate; }
+    
     // Update only a specific region of the world (optimization for large worlds)
     void update(int startX, int startY, int endX, int endY);
     
+    // Simulation time per tick in microseconds (0 = no limit). Dirty chunks are updated in
+    // priority order - visible, close to the player, waiting longest - until their expected
+    // cost fills the budget; the others roll over to the next tick and gain priority as they wait.
+    void setSimulationBudget(int microseconds) { m_simulationBudgetMicros = std::max(0, microseconds); }
+    int getSimulationBudget() const { return m_simulationBudgetMicros; }
+    
+    // Part of the world on screen, in world pixels; chunks inside it are simulated first
+    void setView(int x, int y, int width, int height) {
+        m_viewX = x;
+        m_viewY = y;
+        m_viewWidth = width;
+        m_viewHeight = height;
+    }
+    
+    // Number of threads used to update chunks (<= 0 uses every hardware thread)
+    void setSimulationThreads(int threadCount) { m_scheduler.setThreadCount(threadCount); }
+    int getSimulationThreads() const { return m_scheduler.getThreadCount(); }
+    
     // Special processing to level out liquids (fix floating particles)
     void levelLiquids();
     
@@ -253,7 +918,10 @@ public:
     
     // Update active chunks based on camera position
     void updatePlayerPosition(int playerX, int playerY) {
+        m_playerX = playerX;
+        m_playerY = playerY;
         m_chunkManager.updateActiveChunks(playerX, playerY);
+        dropUnscheduledChunks();
     }
     
     // Get the list of active chunks for rendering
@@ -292,6 +960,10 @@ public:
         return m_pixelData.data(); 
     }
     
+    // Rectangles of the pixel data (world coordinates) that the last update changed, so a
+    // renderer can upload just those
+    const std::vector<DirtyRect>& getPixelChanges() const { return m_pixelChanges; }
+    
 private:
     // World dimensions in pixels
     int m_width;
@@ -304,27 +976,108 @@ private:
     // Chunk manager for streaming system
     ChunkManager m_chunkManager;
     
-    // Legacy vector of chunks (will be phased out)
-    std::vector<std::unique_ptr<Chunk>> m_chunks;
+    // Runs chunk updates on worker threads in checkerboard phases
+    ChunkScheduler m_scheduler;
     
     // Optimization: Track dirty chunks for more efficient updates
-    const int PROCESSING_CHUNK_SIZE = 64; // Pixels per processing chunk (smaller than storage chunks)
-    std::vector<std::pair<int, int>> m_dirtyChunks; // Processing chunks that need updates
+    const int PROCESSING_CHUNK_SIZE = Chunk::TILE_SIZE; // Pixels per processing chunk (one tile of a storage chunk)
+    
+    // Processing chunks written since the last update, one bit each (bit tileY * m_tilesX + tileX).
+    // Marking is idempotent, so the bitmap keeps its size however many cells a frame writes.
+    std::vector<uint64_t> m_dirtyTiles;
+    int m_tilesX = 0;
+    
+    void markTileDirty(int x, int y) {
+        int tile = (y / PROCESSING_CHUNK_SIZE) * m_tilesX + x / PROCESSING_CHUNK_SIZE;
+        m_dirtyTiles[tile / 64] |= uint64_t(1) << (tile % 64);
+    }
     
     // For rendering: RGBA pixel data for the entire world
     std::vector<uint8_t> m_pixelData;
+    std::vector<DirtyRect> m_pixelChanges;
     
-    // Random number generator
+    // Random number generator for world generation
     std::mt19937 m_rng;
     
-    // Helper functions
+    // Seed of the simulation's random draws (see SimRandom) and number of simulated updates
+    uint64_t m_seed = 0;
+    uint32_t m_tick = 0;
+    
+    // Fixed-timestep clock state (see advance())
+    double m_tickRate = DEFAULT_TICK_RATE;
+    int m_maxTicksPerAdvance = DEFAULT_MAX_TICKS_PER_ADVANCE;
+    double m_tickAccumulator = 0.0;   // Banked seconds not yet simulated, below one tick
+    
+    // Budgeted chunk scheduling (see setSimulationBudget())
+    struct ChunkSchedule {
+        float updateMicros = 0.0f;    // Smoothed cost of the chunk's recent updates
+        float lastMicros = 0.0f;      // Cost of the latest update, written by the scheduler
+        int waitedTicks = 0;          // Ticks spent dirty without being updated
+    };
+    std::unordered_map<ChunkCoord, ChunkSchedule, ChunkCoordHash> m_chunkSchedule;
+    int m_simulationBudgetMicros = 0;
+    
+    // A visible chunk goes ahead of one that has waited this many ticks fewer
+    static constexpr int VISIBLE_PRIORITY = 4;
+    
+    // Player position and on-screen view, in world pixels
+    int m_playerX = 0;
+    int m_playerY = 0;
+    int m_viewX = 0;
+    int m_viewY = 0;
+    int m_viewWidth = 0;
+    int m_viewHeight = 0;
+    
+    // Chunks of the reduced-rate LOD ring are simulated on every LOD_TICK_INTERVAL-th tick
+    static constexpr uint32_t LOD_TICK_INTERVAL = 4;
+    
+    // Scheduling priority of a dirty chunk: higher runs first
+    int chunkPriority(const ChunkCoord& coord, const ChunkSchedule& schedule) const;
+    
+    // Forget the schedule of chunks that left both the active list and the LOD ring
+    void dropUnscheduledChunks();
+    
+    // Resident (loaded or cached) chunk at chunk coordinates, without loading anything
+    // (nullptr outside the world or when the chunk is not in memory)
     Chunk* getChunkAt(int x, int y);
     const Chunk* getChunkAt(int x, int y) const;
     
+    // The chunks in memory (loaded or cached) around a chunk, which Chunk::update syncs its halo with
+    ChunkNeighbors getChunkNeighbors(int chunkX, int chunkY);
+    
+    // Call f(editor, originX, originY, x0, y0, x1, y1) for every chunk overlapping the
+    // rectangle (clipped to the world), with the chunk's world origin and the inclusive
+    // chunk-local bounds of the overlap. Chunks are loaded as needed.
+    template <typename F>
+    void forEachChunkInRect(int x, int y, int width, int height, F&& f) {
+        int startX = std::max(0, x);
+        int startY = std::max(0, y);
+        int endX = std::min(m_width, x + width);      // Exclusive
+        int endY = std::min(m_height, y + height);
+        if (startX >= endX || startY >= endY) {
+            return;
+        }
+        for (int chunkY = startY / Chunk::HEIGHT; chunkY <= (endY - 1) / Chunk::HEIGHT; ++chunkY) {
+            for (int chunkX = startX / Chunk::WIDTH; chunkX <= (endX - 1) / Chunk::WIDTH; ++chunkX) {
+                Chunk* chunk = m_chunkManager.getChunk(chunkX, chunkY, true);
+                if (!chunk) continue;
+                
+                int originX = chunkX * Chunk::WIDTH;
+                int originY = chunkY * Chunk::HEIGHT;
+                Chunk::Editor editor(*chunk);
+                f(editor, originX, originY,
+                  std::max(startX, originX) - originX, std::max(startY, originY) - originY,
+                  std::min(endX, originX + Chunk::WIDTH) - 1 - originX,
+                  std::min(endY, originY + Chunk::HEIGHT) - 1 - originY);
+            }
+        }
+    }
+    
     // Convert between world and chunk coordinates
     void worldToChunkCoords(int worldX, int worldY, int& chunkX, int& chunkY, int& localX, int& localY) const;
     
-    // Update the combined pixel data from all chunks for rendering
+    // Copy the pixels the resident chunks recoloured since the last call into the combined
+    // pixel data, and list the changed rectangles in m_pixelChanges
     void updateWorldPixelData();
     
     // World generation helper functions
@@ -104,57 +104,51 @@ void Character::draw() {
         }
         
         // Draw the segment as two parts: inner body and outer armor/skin
-        // This creates a more complex, layered appearance
-        for (int dy = -segmentRadius; dy <= segmentRadius; ++dy) {
-            for (int dx = -segmentRadius; dx <= segmentRadius; ++dx) {
-                // Distance from center of segment
-                float distFromCenter = std::sqrt(dx*dx + dy*dy);
-                
-                // Skip pixels outside the segment radius
-                if (distFromCenter > segmentRadius) continue;
-                
-                // Calculate world position
-                int x = segment.x + dx;
-                int y = segment.y + dy;
-                
-                // Make sure we're within world bounds
-                if (x < 0 || x >= m_world.getWidth() || y < 0 || y >= m_world.getHeight()) {
-                    continue;
+        // This creates a more complex, layered appearance (the edit is clipped to the world)
+        m_world.editRect(segment.x - segmentRadius, segment.y - segmentRadius,
+                         2 * segmentRadius + 1, 2 * segmentRadius + 1,
+                         [&](int x, int y, MaterialType current) {
+            int dx = x - segment.x;
+            int dy = y - segment.y;
+            
+            // Distance from center of segment
+            float distFromCenter = std::sqrt(dx*dx + dy*dy);
+            
+            // Leave pixels outside the segment radius alone
+            if (distFromCenter > segmentRadius) return current;
+            
+            // Determine material based on segment type and position
+            MaterialType material;
+            
+            if (i == 0) {
+                // Head segment with a simple mouth
+                if (distFromCenter < segmentRadius * 0.4f) {
+                    // Mouth area in the center of head
+                    material = m_mouthMaterial;
+                } else {
+                    // Outer head
+                    material = m_headMaterial;
                 }
+            } else {
+                // Body segments - darker coloration
+                // Create a segmented pattern alternating between skin and armor
+                bool isArmored;
                 
-                // Determine material based on segment type and position
-                MaterialType material;
-                
-                if (i == 0) {
-                    // Head segment with a simple mouth
-                    if (distFromCenter < segmentRadius * 0.4f) {
-                        // Mouth area in the center of head
-                        material = m_mouthMaterial;
-                    } else {
-                        // Outer head
-                        material = m_headMaterial;
-                    }
+                if (i % 2 == 0) {
+                    // Even segments have armor on outside
+                    isArmored = (distFromCenter > segmentRadius * 0.7f);
                 } else {
-                    // Body segments - darker coloration
-                    // Create a segmented pattern alternating between skin and armor
-                    bool isArmored;
-                    
-                    if (i % 2 == 0) {
-                        // Even segments have armor on outside
-                        isArmored = (distFromCenter > segmentRadius * 0.7f);
-                    } else {
-                        // Odd segments have armor on inside
-                        isArmored = (distFromCenter < segmentRadius * 0.5f);
-                    }
-                    
-                    // Apply appropriate material
-                    material = isArmored ? m_armorMaterial : m_skinMaterial;
+                    // Odd segments have armor on inside
+                    isArmored = (distFromCenter < segmentRadius * 0.5f);
                 }
                 
-                // Set the material in the world
-                m_world.set(x, y, material);
+                // Apply appropriate material
+                material = isArmored ? m_armorMaterial : m_skinMaterial;
             }
-        }
+            
+            // Set the material in the world
+            return material;
+        });
     }
 }
 
@@ -168,91 +162,79 @@ void Character::clear() {
     int clearRadius = m_radius + 1;
     
     for (const Segment& segment : m_segments) {
-        for (int dy = -clearRadius; dy <= clearRadius; ++dy) {
-            for (int dx = -clearRadius; dx <= clearRadius; ++dx) {
-                // Check if point is within radius for circular shape
-                if (dx*dx + dy*dy <= clearRadius*clearRadius) {
-                    int x = segment.x + dx;
-                    int y = segment.y + dy;
-                    
-                    // Make sure we're within world bounds
-                    if (x >= 0 && x < m_world.getWidth() && y >= 0 && y < m_world.getHeight()) {
-                        // Only clear worm materials, not terrain
-                        MaterialType material = m_world.get(x, y);
-                        if (material == m_headMaterial || 
-                            material == m_mouthMaterial || 
-                            material == m_skinMaterial || 
-                            material == m_armorMaterial) {
-                            m_world.set(x, y, MaterialType::Empty);
-                        }
-                    }
-                }
+        m_world.editRect(segment.x - clearRadius, segment.y - clearRadius,
+                         2 * clearRadius + 1, 2 * clearRadius + 1,
+                         [&](int x, int y, MaterialType material) {
+            // Check if point is within radius for circular shape
+            int dx = x - segment.x;
+            int dy = y - segment.y;
+            if (dx*dx + dy*dy > clearRadius*clearRadius) {
+                return material;
             }
-        }
+            
+            // Only clear worm materials, not terrain
+            if (material == m_headMaterial || 
+                material == m_mouthMaterial || 
+                material == m_skinMaterial || 
+                material == m_armorMaterial) {
+                return MaterialType::Empty;
+            }
+            return material;
+        });
     }
 }
 
 void Character::eatEarth(int x, int y, int radius) {
     // Eat (clear) the earth around the given position
-    // This is the worm's mouth action
-    for (int dy = -radius; dy <= radius; ++dy) {
-        for (int dx = -radius; dx <= radius; ++dx) {
-            // Distance from center (for circular shape)
-            float distSq = dx*dx + dy*dy;
-            float mouthRadius = radius * 0.7f; // Mouth is slightly smaller than head
-            
-            // World coordinates
-            int eatX = x + dx;
-            int eatY = y + dy;
-            
-            // Skip if out of bounds
-            if (eatX < 0 || eatX >= m_world.getWidth() || eatY < 0 || eatY >= m_world.getHeight()) {
-                continue;
-            }
-            
-            // Get the current material at this position
-            MaterialType material = m_world.get(eatX, eatY);
-            
-            // Skip empty and bedrock
-            if (material == MaterialType::Empty || material == MaterialType::Bedrock) {
-                continue;
-            }
+    // This is the worm's mouth action (the edit is clipped to the world)
+    m_world.editRect(x - radius, y - radius, 2 * radius + 1, 2 * radius + 1,
+                     [&](int eatX, int eatY, MaterialType material) {
+        // Distance from center (for circular shape)
+        int dx = eatX - x;
+        int dy = eatY - y;
+        float distSq = dx*dx + dy*dy;
+        float mouthRadius = radius * 0.7f; // Mouth is slightly smaller than head
+        
+        // Skip empty and bedrock
+        if (material == MaterialType::Empty || material == MaterialType::Bedrock) {
+            return material;
+        }
+        
+        // Determine what to do based on distance from center
+        if (distSq <= mouthRadius*mouthRadius) {
+            // Inner area - eat completely
+            return MaterialType::Empty;
+        } 
+        else if (distSq <= radius*radius) {
+            // Outer area - modify terrain based on material
             
-            // Determine what to do based on distance from center
-            if (distSq <= mouthRadius*mouthRadius) {
-                // Inner area - eat completely
-                m_world.set(eatX, eatY, MaterialType::Empty);
-            } 
-            else if (distSq <= radius*radius) {
-                // Outer area - modify terrain based on material
-                
-                // Different behavior based on material type
-                if (material == MaterialType::Stone || material == MaterialType::DenseRock) {
-                    // Turn stone to gravel (break it up)
-                    if (std::rand() % 100 < 70) {
-                        m_world.set(eatX, eatY, MaterialType::Gravel);
-                    }
+            // Different behavior based on material type
+            if (material == MaterialType::Stone || material == MaterialType::DenseRock) {
+                // Turn stone to gravel (break it up)
+                if (std::rand() % 100 < 70) {
+                    return MaterialType::Gravel;
                 }
-                else if (material == MaterialType::Dirt || material == MaterialType::TopSoil) {
-                    // Churn up dirt, making it looser
-                    if (std::rand() % 100 < 80) {
-                        m_world.set(eatX, eatY, MaterialType::Sand);
-                    }
-                }
-                else if (material == MaterialType::Sand || material == MaterialType::Sandstone) {
-                    // Loosen sandstone to sand
-                    if (material == MaterialType::Sandstone && std::rand() % 100 < 60) {
-                        m_world.set(eatX, eatY, MaterialType::Sand);
-                    }
+            }
+            else if (material == MaterialType::Dirt || material == MaterialType::TopSoil) {
+                // Churn up dirt, making it looser
+                if (std::rand() % 100 < 80) {
+                    return MaterialType::Sand;
                 }
-                else if (material == MaterialType::Grass) {
-                    // Remove grass, leave dirt
-                    m_world.set(eatX, eatY, MaterialType::Dirt);
+            }
+            else if (material == MaterialType::Sand || material == MaterialType::Sandstone) {
+                // Loosen sandstone to sand
+                if (material == MaterialType::Sandstone && std::rand() % 100 < 60) {
+                    return MaterialType::Sand;
                 }
-                // Other materials remain unchanged in the outer radius
             }
+            else if (material == MaterialType::Grass) {
+                // Remove grass, leave dirt
+                return MaterialType::Dirt;
+            }
+            // Other materials remain unchanged in the outer radius
         }
-    }
+        return material;
+    });
 }
 
 float Character::calculateDistanceBetween(int x1, int y1, int x2, int y2) const {
@@ -60,6 +60,21 @@ Chunk* ChunkManager::getChunk(int chunkX, int chunkY, bool loadIfNeeded) {
     return chunkPtr;
 }
 
+Chunk* ChunkManager::getResidentChunk(int chunkX, int chunkY) {
+    ChunkCoord coord{chunkX, chunkY};
+    
+    auto it = m_loadedChunks.find(coord);
+    if (it != m_loadedChunks.end()) {
+        return it->second.get();
+    }
+    
+    auto cacheIt = m_chunkCache.find(coord);
+    if (cacheIt != m_chunkCache.end()) {
+        return cacheIt->second.chunk.get();
+    }
+    return nullptr;
+}
+
 void ChunkManager::updateActiveChunks(int centerX, int centerY) {
     // Convert center position to chunk coordinates
     int centerChunkX, centerChunkY, localX, localY;
@@ -158,6 +173,20 @@ void ChunkManager::updateActiveChunks(int centerX, int centerY) {
     // Update active chunks list
     m_activeChunks = desiredChunks;
     
+    // Split the cached chunks into the reduced-rate ring and the far tier. Far chunks still in
+    // motion are settled to rest and saved again, so they are not left half-simulated on disk.
+    m_lodChunks.clear();
+    for (auto& entry : m_chunkCache) {
+        const ChunkCoord& coord = entry.first;
+        Chunk* chunk = entry.second.chunk.get();
+        int distance = std::max(std::abs(coord.x - centerChunkX), std::abs(coord.y - centerChunkY));
+        if (distance <= LOD_RING_RADIUS) {
+            m_lodChunks.push_back(coord);
+        } else if ((chunk->isDirty() || chunk->shouldUpdateNextFrame()) && chunk->settle()) {
+            saveChunk(coord);
+        }
+    }
+    
     // Only output active chunks when they change
     static std::vector<ChunkCoord> lastActiveChunks;
     if (lastActiveChunks != m_activeChunks) {
@@ -205,6 +234,16 @@ void ChunkManager::saveAllModifiedChunks() {
     m_dirtyChunks.clear();
 }
 
+void ChunkManager::setRandomSeed(uint64_t worldSeed) {
+    m_randomSeed = worldSeed;
+    for (auto& entry : m_loadedChunks) {
+        entry.second->setRandomSeed(worldSeed);
+    }
+    for (auto& entry : m_chunkCache) {
+        entry.second.chunk->setRandomSeed(worldSeed);
+    }
+}
+
 bool ChunkManager::isChunkVisible(int chunkX, int chunkY, int cameraX, int cameraY, 
                                  int screenWidth, int screenHeight) const {
     // Calculate chunk boundaries in world coordinates
@@ -240,13 +279,11 @@ std::string ChunkManager::getChunkFilePath(const ChunkCoord& coord) const {
 }
 
 bool ChunkManager::saveChunk(const ChunkCoord& coord) {
-    auto it = m_loadedChunks.find(coord);
-    if (it == m_loadedChunks.end()) {
-        return false; // Chunk not loaded
+    const Chunk* chunk = getResidentChunk(coord.x, coord.y);
+    if (!chunk) {
+        return false; // Chunk not in memory
     }
     
-    const Chunk* chunk = it->second.get();
-    
     // Skip if not modified
     if (!chunk->isModified()) {
         return true;
@@ -289,6 +326,7 @@ std::unique_ptr<Chunk> ChunkManager::loadChunk(const ChunkCoord& coord) {
     int posX = coord.x * m_chunkSize;
     int posY = coord.y * m_chunkSize;
     auto chunk = std::make_unique<Chunk>(posX, posY);
+    chunk->setRandomSeed(m_randomSeed);
     
     // Deserialize chunk data
     if (!chunk->deserialize(file)) {
@@ -344,7 +382,9 @@ std::unique_ptr<Chunk> ChunkManager::createNewChunk(const ChunkCoord& coord) {
     if (createCounter++ % 10 == 0) {
         // std::cout << "Creating new chunk at position (" << posX << "," << posY << ")" << std::endl;
     }
-    return std::make_unique<Chunk>(posX, posY);
+    auto chunk = std::make_unique<Chunk>(posX, posY);
+    chunk->setRandomSeed(m_randomSeed);
+    return chunk;
 }
 
 } // namespace PixelPhys
\ No newline at end of file
@@ -0,0 +1,143 @@
+#include "../include/ChunkScheduler.h"
+#include "../include/World.h"
+#include <algorithm>
+#include <chrono>
+
+namespace PixelPhys {
+
+// ThreadPool implementation
+
+ThreadPool::ThreadPool(int threadCount) {
+    if (threadCount <= 0) {
+        threadCount = static_cast<int>(std::thread::hardware_concurrency());
+    }
+    threadCount = std::max(1, threadCount);
+    
+    // The caller runs jobs too, so only spawn threadCount - 1 workers
+    m_workers.reserve(threadCount - 1);
+    for (int i = 1; i < threadCount; ++i) {
+        m_workers.emplace_back(&ThreadPool::workerLoop, this);
+    }
+}
+
+ThreadPool::~ThreadPool() {
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        m_stopping = true;
+    }
+    m_batchReady.notify_all();
+    for (auto& worker : m_workers) {
+        worker.join();
+    }
+}
+
+void ThreadPool::parallelFor(int count, const std::function<void(int)>& job) {
+    if (count <= 0) {
+        return;
+    }
+    
+    // Nothing to share - skip the wake-up round trip
+    if (count == 1 || m_workers.empty()) {
+        for (int i = 0; i < count; ++i) {
+            job(i);
+        }
+        return;
+    }
+    
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        m_job = &job;
+        m_jobCount = count;
+        m_nextJob.store(0, std::memory_order_relaxed);
+        m_busyWorkers = static_cast<int>(m_workers.size());
+        m_batchId++;
+    }
+    m_batchReady.notify_all();
+    
+    runJobs();
+    
+    // Barrier: wait until every worker has left this batch
+    std::unique_lock<std::mutex> lock(m_mutex);
+    m_batchDone.wait(lock, [this] { return m_busyWorkers == 0; });
+    m_job = nullptr;
+}
+
+void ThreadPool::workerLoop() {
+    uint64_t lastBatch = 0;
+    while (true) {
+        {
+            std::unique_lock<std::mutex> lock(m_mutex);
+            m_batchReady.wait(lock, [&] { return m_stopping || m_batchId != lastBatch; });
+            if (m_stopping) {
+                return;
+            }
+            lastBatch = m_batchId;
+        }
+        
+        runJobs();
+        
+        {
+            std::lock_guard<std::mutex> lock(m_mutex);
+            if (--m_busyWorkers == 0) {
+                m_batchDone.notify_one();
+            }
+        }
+    }
+}
+
+void ThreadPool::runJobs() {
+    while (true) {
+        int i = m_nextJob.fetch_add(1, std::memory_order_relaxed);
+        if (i >= m_jobCount) {
+            return;
+        }
+        (*m_job)(i);
+    }
+}
+
+// ChunkScheduler implementation
+
+ChunkScheduler::ChunkScheduler(int threadCount) 
+    : m_pool(std::make_unique<ThreadPool>(threadCount)) {
+}
+
+void ChunkScheduler::setThreadCount(int threadCount) {
+    m_pool = std::make_unique<ThreadPool>(threadCount);
+}
+
+void ChunkScheduler::addChunk(int chunkX, int chunkY, Chunk* chunk, const ChunkNeighbors& neighbors,
+                              float* updateMicros) {
+    if (!chunk) return;
+    
+    // 2x2 checkerboard: chunks that share an edge or a corner never share a phase
+    // (works for negative coordinates too, since & 1 looks at the two's complement bit)
+    int phase = (chunkX & 1) + 2 * (chunkY & 1);
+    m_phases[phase].push_back({chunk, neighbors, updateMicros});
+}
+
+int ChunkScheduler::getQueuedCount() const {
+    int count = 0;
+    for (const auto& phase : m_phases) {
+        count += static_cast<int>(phase.size());
+    }
+    return count;
+}
+
+void ChunkScheduler::run() {
+    for (auto& phase : m_phases) {
+        m_pool->parallelFor(static_cast<int>(phase.size()), [&phase](int i) {
+            const Job& job = phase[i];
+            if (!job.updateMicros) {
+                job.chunk->update(job.neighbors);
+                return;
+            }
+            auto start = std::chrono::steady_clock::now();
+            job.chunk->update(job.neighbors);
+            *job.updateMicros = std::chrono::duration<float, std::micro>(
+                std::chrono::steady_clock::now() - start).count();
+        });
+        phase.clear();
+    }
+}
+
+} // namespace PixelPhys
@@ -0,0 +1,439 @@
+#include "../include/MaterialPalette.h"
+#include "../include/World.h"
+#include "../include/SimRandom.h"
+#include <algorithm>
+#include <cstddef>
+#include <cstring>
+
+#if defined(__x86_64__) && (defined(__GNUC__) || defined(__clang__))
+#include <immintrin.h>
+#define PIXELPHYS_AVX2_COLORIZE 1
+#endif
+
+namespace PixelPhys {
+
+namespace {
+
+// Per-channel texture offsets of a material for one set of position hashes, with
+// posHash1 in [0, 32), posHash2 in [0, 64) and posHash3 in [0, 16)
+constexpr void textureVariation(MaterialType material, int posHash1, int posHash2, int posHash3,
+                                int& rVariation, int& gVariation, int& bVariation) {
+    // Different variation for each color channel - MODERATE VARIATION
+    rVariation = ((posHash1 % 35) - 17) * 2;  // Moderate variation
+    gVariation = ((posHash2 % 31) - 15) * 2;  // Moderate variation
+    bVariation = ((posHash3 % 27) - 13) * 2;  // Moderate variation
+    
+    // Apply material-specific variation patterns
+    // Various materials have their own unique texture patterns
+    switch (material) {
+        case MaterialType::Stone:
+            // Stone has gray variations with strong texture
+            rVariation = gVariation = bVariation = ((posHash1 % 45) - 22) * 5;
+            // Add dark speckles
+            if (posHash2 % 5 == 0) {
+                rVariation -= 50;
+                gVariation -= 50;
+                bVariation -= 50;
+            }
+            break;
+        case MaterialType::Grass:
+            // Grass has strong green variations with patches
+            gVariation = ((posHash1 % 50) - 15) * 5; // 5x stronger green variation
+            rVariation = ((posHash2 % 25) - 15) * 5; // 5x stronger yellowish tints
+            // Add occasional darker patches
+            if (posHash1 % 3 == 0) {
+                gVariation -= 60;
+                rVariation -= 40;
+            }
+            break;
+        case MaterialType::Sand:
+            // Sand has strong yellow-brown variations with visible texture
+            rVariation = (posHash1 % 30) - 10;
+            gVariation = (posHash1 % 25) - 12;
+            bVariation = (posHash3 % 15) - 10;
+            // Add occasional darker grains
+            if (posHash2 % 4 == 0) {
+                rVariation -= 15;
+                gVariation -= 15;
+            }
+            break;
+        case MaterialType::Dirt:
+            // Dirt has rich brown variations with texture
+            rVariation = (posHash1 % 40) - 15;
+            gVariation = (posHash2 % 30) - 15;
+            bVariation = (posHash3 % 20) - 12;
+            // Add occasional darker and lighter patches
+            if (posHash2 % 5 == 0) {
+                rVariation -= 20;
+                gVariation -= 20;
+                bVariation -= 10;
+            } else if (posHash2 % 7 == 0) {
+                rVariation += 15;
+                gVariation += 10;
+            }
+            break;
+        case MaterialType::Snow:
+            // Snow has very subtle blue-white variations
+            rVariation = gVariation = bVariation = (posHash1 % 7) - 3;
+            break;
+        case MaterialType::Sandstone:
+            // Sandstone has beige-tan variations
+            rVariation = (posHash1 % 16) - 8;
+            gVariation = (posHash2 % 14) - 7;
+            bVariation = (posHash3 % 8) - 4;
+            break;
+        case MaterialType::Bedrock:
+            // Bedrock has dark gray variations with some texture
+            rVariation = gVariation = bVariation = (posHash1 % 20) - 8;
+            // Add some occasional darker spots for texture
+            if (posHash2 % 8 == 0) {
+                rVariation -= 10;
+                gVariation -= 10;
+                bVariation -= 10;
+            }
+            break;
+        case MaterialType::Gravel:
+            // Gravel has strong texture with varied gray tones
+            rVariation = gVariation = bVariation = (posHash1 % 35) - 17;
+            // Add mixed size pebble effect
+            if (posHash2 % 7 == 0) {
+                rVariation -= 25;
+                gVariation -= 25;
+                bVariation -= 25;
+            } else if (posHash2 % 11 == 0) {
+                rVariation += 15;
+                gVariation += 15;
+                bVariation += 15;
+            }
+            break;
+        case MaterialType::TopSoil:
+            // Topsoil has rich brown variations with organic texture
+            rVariation = (posHash1 % 25) - 10;
+            gVariation = (posHash2 % 20) - 10;
+            bVariation = (posHash3 % 12) - 6;
+            // Add darker organic matter patches
+            if (posHash2 % 4 == 0) {
+                rVariation -= 15;
+                gVariation -= 12;
+                bVariation -= 5;
+            }
+            break;
+        case MaterialType::DenseRock:
+            // Dense rock has dark blue-gray coloration with crystalline texture
+            rVariation = (posHash1 % 18) - 9;
+            gVariation = (posHash1 % 18) - 9;
+            bVariation = (posHash1 % 22) - 9; // Slight blue tint
+            // Add occasional mineral veins or crystalline structures
+            if (posHash2 % 9 == 0) {
+                rVariation += 10;
+                gVariation += 12;
+                bVariation += 15; // Blueish highlights
+            } else if (posHash2 % 16 == 0) {
+                rVariation -= 15;
+                gVariation -= 15;
+                bVariation -= 10; // Dark patches
+            }
+            break;
+        case MaterialType::Water:
+            // Water has blue variations with some subtle waves
+            bVariation = (posHash1 % 18) - 9;
+            // Slight green tint variations for depth perception
+            gVariation = (posHash2 % 10) - 5;
+            // Very minimal red variation
+            rVariation = (posHash3 % 4) - 2;
+            break;
+        case MaterialType::Lava:
+            // Lava has hot red-orange variations with bright spots
+            rVariation = (posHash1 % 30) - 5; // More red, less reduction
+            gVariation = (posHash2 % 25) - 15; // More variation in orange
+            bVariation = (posHash3 % 6) - 3; // Minor blue variation
+            // Add occasional bright yellow-white spots
+            if (posHash2 % 10 == 0) {
+                rVariation += 20;
+                gVariation += 15;
+            }
+            break;
+        case MaterialType::GrassStalks:
+            // Grass stalks have varied green shades
+            gVariation = (posHash1 % 22) - 8; // Strong green variation
+            rVariation = (posHash2 % 10) - 5; // Some red variation for yellowish/brownish tints
+            bVariation = (posHash3 % 8) - 4; // Minor blue variation
+            break;
+        case MaterialType::Fire:
+            // Fire has flickering yellow-orange-red variations
+            rVariation = (posHash1 % 20) - 5; // Strong red
+            gVariation = (posHash2 % 30) - 15; // Varied green for yellow/orange
+            bVariation = (posHash3 % 10) - 8; // Minimal blue
+            // Random bright spots
+            if (posHash2 % 5 == 0) {
+                rVariation += 15;
+                gVariation += 10;
+            }
+            break;
+        case MaterialType::Oil:
+            // Oil has dark brown-black variations with slight shine
+            rVariation = (posHash1 % 12) - 8;
+            gVariation = (posHash2 % 10) - 7;
+            bVariation = (posHash3 % 8) - 6;
+            // Occasional slight shine
+            if (posHash2 % 12 == 0) {
+                rVariation += 8;
+                gVariation += 8;
+                bVariation += 8;
+            }
+            break;
+        case MaterialType::FlammableGas:
+            // Flammable gas has subtle greenish variations with transparency
+            gVariation = (posHash1 % 15) - 5;
+            rVariation = (posHash2 % 8) - 4;
+            bVariation = (posHash3 % 8) - 4;
+            break;
+            
+        // Ore material texture variations
+        case MaterialType::IronOre:
+            // Iron ore has gray-blue tints with metallic specks
+            rVariation = gVariation = (posHash1 % 25) - 12;
+            bVariation = (posHash1 % 30) - 12;
+            // Add metallic highlights
+            if (posHash2 % 4 == 0) {
+                rVariation += 25;
+                gVariation += 25;
+                bVariation += 30;
+            }
+            break;
+            
+        case MaterialType::CopperOre:
+            // Copper has orange-brown coloration with patchy texture
+            rVariation = (posHash1 % 40) - 10;  // Strong orange-red variation
+            gVariation = (posHash2 % 25) - 15;  // Less green variation
+            bVariation = (posHash3 % 15) - 10;  // Minimal blue
+            // Add verdigris tint patches
+            if (posHash2 % 6 == 0) {
+                rVariation -= 10;
+                gVariation += 15;
+                bVariation += 5;
+            }
+            break;
+            
+        case MaterialType::GoldOre:
+            // Gold has shiny yellow with highlight sparkles
+            rVariation = (posHash1 % 30) - 10;  // Strong yellow-red
+            gVariation = (posHash2 % 30) - 15;  // Yellow-green
+            bVariation = (posHash3 % 10) - 8;   // Minimal blue
+            // Add shiny spots
+            if (posHash2 % 4 == 0) {
+                rVariation += 30;
+                gVariation += 20;
+            }
+            break;
+            
+        case MaterialType::CoalOre:
+            // Coal has dark with occasional shiny bits
+            rVariation = gVariation = bVariation = (posHash1 % 12) - 9;  // Generally dark
+            // Add occasional shiny anthracite highlights
+            if (posHash2 % 7 == 0) {
+                rVariation += 20;
+                gVariation += 20;
+                bVariation += 20;
+            }
+            break;
+            
+        case MaterialType::DiamondOre:
+            // Diamond has blue-white sparkles in dark matrix
+            rVariation = (posHash1 % 20) - 10;
+            gVariation = (posHash2 % 25) - 10;
+            bVariation = (posHash3 % 35) - 10;  // More blue variation
+            // Add bright sparkles
+            if (posHash2 % 3 == 0) {
+                rVariation += 30;
+                gVariation += 40;
+                bVariation += 50;
+            }
+            break;
+            
+        case MaterialType::SilverOre:
+            // Silver has white-gray with metallic sheen
+            rVariation = gVariation = bVariation = (posHash1 % 30) - 15;
+            // Add reflective highlights
+            if (posHash2 % 5 == 0) {
+                rVariation += 30;
+                gVariation += 30;
+                bVariation += 35;  // Slightly blue tint to highlights
+            }
+            break;
+            
+        case MaterialType::EmeraldOre:
+            // Emerald has vivid green with internal facets
+            rVariation = (posHash1 % 15) - 10;  // Little red
+            gVariation = (posHash2 % 45) - 15;  // Strong green variation
+            bVariation = (posHash3 % 20) - 15;  // Some blue variation
+            // Add crystal facet highlights
+            if (posHash2 % 6 == 0) {
+                rVariation += 5;
+                gVariation += 35;
+                bVariation += 10;
+            }
+            break;
+            
+        case MaterialType::SapphireOre:
+            // Sapphire has deep blue with lighter facets
+            rVariation = (posHash1 % 15) - 12;  // Minimal red
+            gVariation = (posHash2 % 20) - 15;  // Some green
+            bVariation = (posHash3 % 50) - 15;  // Strong blue variation
+            // Add facet highlights
+            if (posHash2 % 5 == 0) {
+                rVariation += 5;
+                gVariation += 15;
+                bVariation += 40;
+            }
+            break;
+            
+        case MaterialType::RubyOre:
+            // Ruby has deep red with bright facets
+            rVariation = (posHash1 % 50) - 15;  // Strong red variation
+            gVariation = (posHash2 % 15) - 12;  // Minimal green
+            bVariation = (posHash3 % 15) - 12;  // Minimal blue
+            // Add facet highlights
+            if (posHash2 % 5 == 0) {
+                rVariation += 40;
+                gVariation += 5;
+                bVariation += 10;
+            }
+            break;
+            
+        case MaterialType::SulfurOre:
+            // Sulfur has bright yellow with matrix patterns
+            rVariation = (posHash1 % 35) - 10;  // Strong red-yellow
+            gVariation = (posHash2 % 35) - 10;  // Strong green-yellow
+            bVariation = (posHash3 % 10) - 8;   // Minimal blue
+            // Add darker matrix
+            if (posHash2 % 4 == 0) {
+                rVariation -= 30;
+                gVariation -= 30;
+            }
+            break;
+            
+        case MaterialType::QuartzOre:
+            // Quartz has white-clear crystal in gray matrix
+            rVariation = gVariation = bVariation = (posHash1 % 25) - 12;
+            // Add bright white crystal
+            if (posHash2 % 3 == 0) {
+                rVariation += 35;
+                gVariation += 35;
+                bVariation += 35;
+            }
+            break;
+            
+        case MaterialType::UraniumOre:
+            // Uranium has greenish glow spots in dark matrix
+            rVariation = (posHash1 % 15) - 10;  // Limited red
+            gVariation = (posHash2 % 40) - 15;  // Strong green variation
+            bVariation = (posHash3 % 15) - 12;  // Limited blue
+            // Add glowing spots
+            if (posHash2 % 4 == 0) {
+                rVariation += 5;
+                gVariation += 60;  // Very bright green glow
+                bVariation += 10;
+            }
+            break;
+            
+        default:
+            // Default variation - still apply some texture for any other materials
+            rVariation = (posHash1 % 12) - 6;
+            gVariation = (posHash2 % 12) - 6;
+            bVariation = (posHash3 % 12) - 6;
+            break;
+    }
+}
+
+// The shades of every material. Variant v stands for one set of position hashes: posHash2
+// takes every value once, so 'one cell in N' speckles keep their frequency, and the other
+// two are scrambled from v.
+constexpr MaterialPalette::Colors buildColors(const MaterialTables& materials) {
+    MaterialPalette::Colors colors{};
+    for (std::size_t i = 0; i < MaterialTables::COUNT; ++i) {
+        const MaterialType material = static_cast<MaterialType>(i);
+        if (material == MaterialType::Empty) continue;  // Empty cells are transparent
+        
+        const MaterialColor& color = materials.color[i];
+        const MaterialColor& variation = materials.variation[i];
+        for (int v = 0; v < MaterialPalette::VARIANTS; ++v) {
+            const uint64_t scrambled = SimRandom::mix(static_cast<uint64_t>(i) << 8 | static_cast<uint64_t>(v));
+            int rVariation = 0, gVariation = 0, bVariation = 0;
+            textureVariation(material, static_cast<int>(scrambled & 31), v, static_cast<int>((scrambled >> 5) & 15),
+                             rVariation, gVariation, bVariation);
+            
+            // Apply the variation to the base color, clamped to the valid range
+            MaterialColor& shade = colors.shades[i * MaterialPalette::VARIANTS + v];
+            shade.r = static_cast<uint8_t>(std::max(0, std::min(255, color.r + rVariation + variation.r)));
+            shade.g = static_cast<uint8_t>(std::max(0, std::min(255, color.g + gVariation + variation.g)));
+            shade.b = static_cast<uint8_t>(std::max(0, std::min(255, color.b + bVariation + variation.b)));
+            shade.a = color.a;
+        }
+    }
+    return colors;
+}
+
+constexpr MaterialPalette::Pattern buildPattern() {
+    MaterialPalette::Pattern pattern{};
+    for (int y = 0; y < MaterialPalette::PATTERN_SIZE; ++y) {
+        for (int x = 0; x < MaterialPalette::PATTERN_SIZE + 8; ++x) {
+            const int wrapped = x % MaterialPalette::PATTERN_SIZE;
+            pattern.variants[y][x] = static_cast<uint8_t>(
+                SimRandom::mix(static_cast<uint64_t>(y) << 32 | static_cast<uint64_t>(wrapped)) % MaterialPalette::VARIANTS);
+        }
+    }
+    return pattern;
+}
+
+#ifdef PIXELPHYS_AVX2_COLORIZE
+// 8 cells per step: the material is the low byte of each 4-byte cell, and one gather fetches
+// the 8 shades, which are already the RGBA bytes to store. 'x' is the pattern column of the
+// first cell; the padding of the pattern rows keeps every step's 8 variants contiguous.
+__attribute__((target("avx2")))
+int colorizeAVX2(const Cell* cells, int count, const uint8_t* variants, int x, const MaterialColor* shades,
+                 uint8_t* pixels) {
+    static_assert(sizeof(Cell) == 4 && offsetof(Cell, material) == 0, "the gather reads the material byte");
+    static_assert(sizeof(MaterialColor) == 4, "one shade per 32-bit lane");
+    const __m256i materialMask = _mm256_set1_epi32(0xFF);
+    int i = 0;
+    for (; i + 8 <= count; i += 8) {
+        const __m256i words = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(cells + i));
+        const __m256i material = _mm256_and_si256(words, materialMask);
+        const uint8_t* step = variants + ((x + i) & (MaterialPalette::PATTERN_SIZE - 1));
+        const __m256i variant = _mm256_cvtepu8_epi32(_mm_loadl_epi64(reinterpret_cast<const __m128i*>(step)));
+        const __m256i index = _mm256_add_epi32(_mm256_slli_epi32(material, 6), variant);
+        const __m256i rgba = _mm256_i32gather_epi32(reinterpret_cast<const int*>(shades), index, 4);
+        _mm256_storeu_si256(reinterpret_cast<__m256i*>(pixels + i * 4), rgba);
+    }
+    return i;
+}
+static_assert(MaterialPalette::VARIANTS == 1 << 6, "colorizeAVX2 shifts material ids by 6");
+#endif
+
+} // namespace
+
+MaterialPalette::Colors MaterialPalette::s_colors = buildColors(BUILTIN_MATERIAL_TABLES);
+const MaterialPalette::Pattern MaterialPalette::s_pattern = buildPattern();
+
+void MaterialPalette::rebuild() {
+    s_colors = buildColors(MaterialRegistry::tables());
+}
+
+void MaterialPalette::colorizeRow(const Cell* cells, int count, int x, int y, uint8_t* pixels) {
+    const uint8_t* variants = s_pattern.variants[y & (PATTERN_SIZE - 1)];
+    int done = 0;
+#ifdef PIXELPHYS_AVX2_COLORIZE
+    static const bool hasAVX2 = __builtin_cpu_supports("avx2");
+    if (hasAVX2) {
+        done = colorizeAVX2(cells, count, variants, x, s_colors.shades, pixels);
+    }
+#endif
+    for (; done < count; ++done) {
+        const uint8_t variant = variants[(x + done) & (PATTERN_SIZE - 1)];
+        const MaterialColor& shade = s_colors.shades[colorIndex(cells[done].material, variant)];
+        std::memcpy(pixels + done * 4, &shade, 4);
+    }
+}
+
+} // namespace PixelPhys
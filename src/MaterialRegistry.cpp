@@ -0,0 +1,251 @@
+#include "../include/MaterialRegistry.h"
+#include <algorithm>
+#include <cctype>
+#include <fstream>
+#include <iostream>
+#include <sstream>
+#include <vector>
+
+namespace PixelPhys {
+
+namespace {
+
+// Display names in MaterialType order; definition files refer to materials by these
+constexpr const char* MATERIAL_NAMES[] = {
+    "Empty", "Sand", "Water", "Stone", "Fire", "Oil", "Grass Stalks", "Dirt", "Flammable Gas",
+    "Grass", "Lava", "Snow", "Bedrock", "Sandstone", "Gravel", "Top Soil", "Dense Rock",
+    "Iron Ore", "Copper Ore", "Gold Ore", "Coal Ore", "Diamond Ore", "Silver Ore",
+    "Emerald Ore", "Sapphire Ore", "Ruby Ore", "Sulfur Ore", "Quartz Ore", "Uranium Ore",
+    "Worm Skin", "Worm Armor", "Worm Head", "Worm Blood", "Worm Mouth"
+};
+static_assert(sizeof(MATERIAL_NAMES) / sizeof(MATERIAL_NAMES[0]) == MaterialTables::COUNT,
+              "every material needs a name");
+
+constexpr uint8_t CATEGORY_FLAGS = MATERIAL_SOLID | MATERIAL_LIQUID | MATERIAL_POWDER | MATERIAL_GAS;
+
+std::string trim(const std::string& text) {
+    const auto first = std::find_if_not(text.begin(), text.end(), [](unsigned char c) { return std::isspace(c); });
+    const auto last = std::find_if_not(text.rbegin(), text.rend(), [](unsigned char c) { return std::isspace(c); }).base();
+    return first < last ? std::string(first, last) : std::string();
+}
+
+std::string lowercase(std::string text) {
+    std::transform(text.begin(), text.end(), text.begin(), [](unsigned char c) { return std::tolower(c); });
+    return text;
+}
+
+// Whole-value integer parsers for the field types; false on anything malformed or out of range
+bool parseInts(const std::string& value, int* out, int count, int maxValue) {
+    std::istringstream in(value);
+    for (int i = 0; i < count; ++i) {
+        if (!(in >> out[i]) || out[i] < 0 || out[i] > maxValue) {
+            return false;
+        }
+    }
+    std::string rest;
+    return !(in >> rest);
+}
+
+bool parseColor(const std::string& value, MaterialColor& color) {
+    int rgb[3];
+    if (!parseInts(value, rgb, 3, 255)) {
+        return false;
+    }
+    color.r = static_cast<uint8_t>(rgb[0]);
+    color.g = static_cast<uint8_t>(rgb[1]);
+    color.b = static_cast<uint8_t>(rgb[2]);
+    return true;
+}
+
+bool parseFlag(const std::string& value, uint8_t& flags, uint8_t flag) {
+    const std::string word = lowercase(value);
+    if (word == "yes" || word == "true") {
+        flags |= flag;
+    } else if (word == "no" || word == "false") {
+        flags &= static_cast<uint8_t>(~flag);
+    } else {
+        return false;
+    }
+    return true;
+}
+
+bool parseCategory(const std::string& value, uint8_t& flags) {
+    const std::string word = lowercase(value);
+    uint8_t category = 0;
+    if (word == "solid") category = MATERIAL_SOLID;
+    else if (word == "liquid") category = MATERIAL_LIQUID;
+    else if (word == "powder") category = MATERIAL_POWDER;
+    else if (word == "gas") category = MATERIAL_GAS;
+    else if (word != "other") return false;
+    flags = static_cast<uint8_t>((flags & ~CATEGORY_FLAGS) | category);
+    return true;
+}
+
+// Comma-separated parts of a value, trimmed
+std::vector<std::string> splitList(const std::string& value) {
+    std::vector<std::string> parts;
+    std::istringstream in(value);
+    for (std::string part; std::getline(in, part, ',');) {
+        parts.push_back(trim(part));
+    }
+    return parts;
+}
+
+// Largest blast radius a reaction may have
+constexpr int MAX_BLAST = 8;
+
+// 'neighbour, chance, product, neighbour product[, blast]' or 'none'. The first reaction line of
+// a section replaces the material's reactions ('replaced' tracks that), later ones append.
+bool parseReaction(const std::string& value, MaterialTables& tables, std::size_t i, bool& replaced) {
+    MaterialReaction (&list)[MaterialTables::MAX_REACTIONS] = tables.reactions[i];
+    if (!replaced) {
+        std::fill(std::begin(list), std::end(list), MaterialReaction{});
+        replaced = true;
+    }
+    if (lowercase(value) == "none") {
+        return true;
+    }
+    
+    const std::vector<std::string> parts = splitList(value);
+    if (parts.size() != 4 && parts.size() != 5) {
+        return false;
+    }
+    MaterialReaction reaction;
+    int chance = 0;
+    int blast = 0;
+    if (lowercase(parts[0]) == "flammable") {
+        reaction.neighborFlags = MATERIAL_FLAMMABLE;
+    } else if (!MaterialRegistry::find(parts[0], reaction.neighbor)) {
+        return false;
+    }
+    if (!parseInts(parts[1], &chance, 1, 255) || chance == 0 ||
+        !MaterialRegistry::find(parts[2], reaction.product) ||
+        !MaterialRegistry::find(parts[3], reaction.neighborProduct) ||
+        (parts.size() == 5 && !parseInts(parts[4], &blast, 1, MAX_BLAST))) {
+        return false;
+    }
+    reaction.chance = static_cast<uint8_t>(chance);
+    reaction.blast = static_cast<uint8_t>(blast);
+    return tables.addReaction(static_cast<MaterialType>(i), reaction);
+}
+
+// 'percent, product'
+bool parseDecay(const std::string& value, MaterialDecay& decay) {
+    const std::vector<std::string> parts = splitList(value);
+    int percent = 0;
+    if (parts.size() != 2 || !parseInts(parts[0], &percent, 1, 100) ||
+        !MaterialRegistry::find(parts[1], decay.product)) {
+        return false;
+    }
+    decay.percent = static_cast<uint8_t>(percent);
+    return true;
+}
+
+// Apply one 'key = value' line to material i; false if the key or the value is not valid.
+// 'reactionsReplaced' is per section, see parseReaction.
+bool applyField(MaterialTables& tables, std::size_t i, const std::string& key, const std::string& value,
+                bool& reactionsReplaced) {
+    int number = 0;
+    if (key == "reaction") return parseReaction(value, tables, i, reactionsReplaced);
+    if (key == "decay") return parseDecay(value, tables.decay[i]);
+    if (key == "lifetime") {
+        if (!parseInts(value, &number, 1, 255)) return false;
+        tables.lifetime[i] = static_cast<uint8_t>(number);
+        return true;
+    }
+    if (key == "category") return parseCategory(value, tables.flags[i]);
+    if (key == "flammable") return parseFlag(value, tables.flags[i], MATERIAL_FLAMMABLE);
+    if (key == "passable") return parseFlag(value, tables.flags[i], MATERIAL_PASSABLE);
+    if (key == "color") return parseColor(value, tables.color[i]);
+    if (key == "variation") return parseColor(value, tables.variation[i]);
+    if (key == "density") {
+        if (!parseInts(value, &number, 1, UINT16_MAX)) return false;
+        tables.density[i] = static_cast<uint16_t>(number);
+        return true;
+    }
+    if (key == "transparency") {
+        if (!parseInts(value, &number, 1, 255)) return false;
+        tables.color[i].a = static_cast<uint8_t>(number);
+        return true;
+    }
+    if (key == "inertia") {
+        if (!parseInts(value, &number, 1, 100)) return false;
+        tables.inertia[i] = static_cast<uint8_t>(number);
+        return true;
+    }
+    if (key == "dispersal") {
+        if (!parseInts(value, &number, 1, 255)) return false;
+        tables.dispersal[i] = static_cast<uint8_t>(number);
+        return true;
+    }
+    return false;
+}
+
+} // namespace
+
+const char* MaterialRegistry::name(MaterialType material) {
+    const std::size_t i = static_cast<std::size_t>(material);
+    return i < MaterialTables::COUNT ? MATERIAL_NAMES[i] : "Unknown";
+}
+
+bool MaterialRegistry::find(const std::string& name, MaterialType& material) {
+    const std::string wanted = lowercase(name);
+    for (std::size_t i = 0; i < MaterialTables::COUNT; ++i) {
+        if (lowercase(MATERIAL_NAMES[i]) == wanted) {
+            material = static_cast<MaterialType>(i);
+            return true;
+        }
+    }
+    return false;
+}
+
+bool MaterialRegistry::loadDefinitions(const std::string& path) {
+    std::ifstream file(path);
+    if (!file) {
+        std::cerr << "Failed to open material definitions: " << path << std::endl;
+        return false;
+    }
+    
+    // Edit a copy, so a bad file leaves the running tables alone
+    MaterialTables tables = s_tables;
+    bool inMaterial = false;
+    bool reactionsReplaced = false;
+    std::size_t current = 0;
+    std::string line;
+    for (int lineNumber = 1; std::getline(file, line); ++lineNumber) {
+        line = trim(line.substr(0, line.find('#')));
+        if (line.empty()) {
+            continue;
+        }
+        
+        if (line.front() == '[' && line.back() == ']') {
+            MaterialType material;
+            if (!find(trim(line.substr(1, line.size() - 2)), material) || material == MaterialType::Empty) {
+                std::cerr << path << ":" << lineNumber << ": unknown material " << line << std::endl;
+                return false;
+            }
+            current = static_cast<std::size_t>(material);
+            inMaterial = true;
+            reactionsReplaced = false;
+            continue;
+        }
+        
+        const std::size_t equals = line.find('=');
+        if (!inMaterial || equals == std::string::npos) {
+            std::cerr << path << ":" << lineNumber << ": expected [Material] or key = value" << std::endl;
+            return false;
+        }
+        const std::string key = lowercase(trim(line.substr(0, equals)));
+        const std::string value = trim(line.substr(equals + 1));
+        if (!applyField(tables, current, key, value, reactionsReplaced)) {
+            std::cerr << path << ":" << lineNumber << ": invalid " << key << " '" << value << "' for "
+                      << MATERIAL_NAMES[current] << std::endl;
+            return false;
+        }
+    }
+    
+    s_tables = tables;
+    return true;
+}
+
+} // namespace PixelPhys
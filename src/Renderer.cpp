@@ -126,10 +126,14 @@ void Renderer::render(const World& world, int cameraX, int cameraY) {
             // Use a step size of 1 to ensure all pixels are rendered clearly
             int step = 1; // Sample every single pixel for perfect visual quality
             
+            // Read the chunk's rows directly rather than through a bounds-checked get() per pixel
+            ChunkView view = chunk->view();
+            
             for (int cy = 0; cy < chunkPixelHeight; cy += step) {
+                const Cell* row = view.row(view.y + cy);
                 for (int cx = 0; cx < chunkPixelWidth; cx += step) {
                     // Get material directly from the chunk
-                    MaterialType material = chunk->get(cx, cy);
+                    MaterialType material = row[cx].material;
                     if (material == MaterialType::Empty) continue;
                     
                     // Calculate world coordinates
@@ -195,256 +199,19 @@ void Renderer::render(const World& world, int cameraX, int cameraY) {
 }
 
 void Renderer::getMaterialColor(MaterialType material, float& r, float& g, float& b, int x, int y) {
-    // Get the raw pixel data directly from the world for the given material
-    // We generate position-based variations for consistent texturing
-    
-    // Get base color
-    const auto& props = MATERIAL_PROPERTIES[static_cast<std::size_t>(material)];
-    
     // Skip processing for empty material
     if (material == MaterialType::Empty) {
         r = g = b = 0.0f;
         return;
     }
     
-    // Create position-based hash for consistent texture patterns
-    int hash = ((x * 13) + (y * 7)) ^ ((x * 23) + (y * 17));
-    
-    // Initial variation values - moderate defaults for all materials
-    int rVar = (hash % 21) - 10;  
-    int gVar = ((hash >> 4) % 21) - 10;
-    int bVar = ((hash >> 16) % 31) - 15;
-    
-    // Material-specific modifications for texture patterns
-    switch (material) {
-        case MaterialType::Stone:
-            // Stone has gray variations with strong texture
-            rVar = gVar = bVar = (hash % 41) - 20;
-            // Add dark speckles
-            if ((hash % 5) == 0) {
-                rVar -= 25;
-                gVar -= 25;
-                bVar -= 25;
-            }
-            break;
-            
-        case MaterialType::Grass:
-            // Grass has strong green variations with patches
-            gVar = (hash % 31) - 15; // More green variation
-            // Add occasional darker patches
-            if ((hash % 7) == 0) {
-                gVar -= 30;
-                rVar -= 15;
-            }
-            break;
-            
-        case MaterialType::TopSoil:
-        case MaterialType::Dirt:
-            // Soil has rich brown variations with texture
-            rVar = (hash % 25) - 12;
-            gVar = ((hash >> 4) % 21) - 10;
-            bVar = ((hash >> 8) % 17) - 8;
-            // Add darker patches
-            if ((hash % 4) == 0) {
-                rVar -= 15;
-                gVar -= 12;
-            }
-            break;
-            
-        case MaterialType::Gravel:
-            // Gravel has strong texture with varied gray tones
-            rVar = gVar = bVar = (hash % 37) - 18;
-            // Add mixed size pebble effect
-            if ((hash % 5) == 0) {
-                rVar -= 25;
-                gVar -= 25;
-                bVar -= 25;
-            } else if ((hash % 11) == 0) {
-                rVar += 15;
-                gVar += 15;
-                bVar += 15;
-            }
-            break;
-            
-        case MaterialType::DenseRock:
-            // Dense rock has dark blue-gray coloration with crystalline texture
-            rVar = (hash % 18) - 9;
-            gVar = (hash % 18) - 9;
-            bVar = (hash % 22) - 9; // Slight blue tint
-            // Add occasional mineral veins or crystalline structures
-            if ((hash % 9) == 0) {
-                bVar += 15; // Blueish highlights
-            }
-            break;
-            
-        case MaterialType::Sand:
-            // Sand has yellow-brown variations with visible texture
-            rVar = (hash % 30) - 10;
-            gVar = (hash % 25) - 12;
-            bVar = (hash % 15) - 8;
-            // Add occasional darker grains
-            if ((hash % 6) == 0) {
-                rVar -= 15;
-                gVar -= 15;
-            }
-            break;
-            
-        case MaterialType::Water:
-            // Water has blue variations with some subtle waves
-            bVar = (hash % 25) - 10;
-            // Slight green tint variations for depth perception
-            gVar = (hash % 15) - 7;
-            // Very minimal red variation
-            rVar = (hash % 6) - 3;
-            break;
-            
-        case MaterialType::Lava:
-            // Lava has hot red-orange variations with bright spots
-            rVar = (hash % 25) - 5; // More red, less reduction
-            gVar = (hash % 25) - 15; // More variation in orange
-            bVar = (hash % 6) - 3; // Minor blue variation
-            // Add occasional bright yellow-white spots
-            if ((hash % 10) == 0) {
-                rVar += 20;
-                gVar += 15;
-            }
-            break;
-            
-        case MaterialType::Snow:
-            // Snow has very subtle blue-white variations
-            rVar = gVar = bVar = (hash % 10) - 5;
-            break;
-            
-        case MaterialType::Bedrock:
-            // Bedrock has dark gray variations with some texture
-            rVar = gVar = bVar = (hash % 15) - 7;
-            // Add some occasional darker spots for texture
-            if ((hash % 8) == 0) {
-                rVar -= 10;
-                gVar -= 10;
-                bVar -= 10;
-            }
-            break;
-            
-        case MaterialType::Sandstone:
-            // Sandstone has beige-tan variations
-            rVar = (hash % 16) - 8;
-            gVar = (hash % 14) - 7;
-            bVar = (hash % 8) - 4;
-            break;
-            
-        case MaterialType::Fire:
-            // Fire has flickering yellow-orange-red variations
-            rVar = (hash % 20) - 5; // Strong red
-            gVar = (hash % 30) - 15; // Varied green for yellow/orange
-            bVar = (hash % 10) - 8; // Minimal blue
-            // Random bright spots
-            if ((hash % 3) == 0) {
-                rVar += 15;
-                gVar += 10;
-            }
-            break;
-            
-        case MaterialType::Oil:
-            // Oil has dark brown-black variations with slight shine
-            rVar = (hash % 12) - 8;
-            gVar = (hash % 10) - 7;
-            bVar = (hash % 8) - 6;
-            // Occasional slight shine
-            if ((hash % 12) == 0) {
-                rVar += 8;
-                gVar += 8;
-                bVar += 8;
-            }
-            break;
-            
-        case MaterialType::GrassStalks:
-            // Grass stalks have varied green shades
-            gVar = (hash % 22) - 8; // Strong green variation
-            rVar = (hash % 10) - 5; // Some red variation for yellowish tints
-            bVar = (hash % 8) - 4; // Minor blue variation
-            break;
-            
-        case MaterialType::FlammableGas:
-            // Flammable gas has subtle greenish variations with transparency
-            gVar = (hash % 15) - 5;
-            rVar = (hash % 8) - 4;
-            bVar = (hash % 8) - 4;
-            break;
-            
-        // Add ore materials
-        case MaterialType::IronOre:
-            // Iron ore has gray-blue tints with metallic specks
-            rVar = gVar = (hash % 25) - 12;
-            bVar = (hash % 30) - 12;
-            // Add metallic highlights
-            if ((hash % 4) == 0) {
-                rVar += 20;
-                gVar += 20;
-                bVar += 25;
-            }
-            break;
-            
-        case MaterialType::CopperOre:
-            // Copper has orange-brown coloration with patchy texture
-            rVar = (hash % 35) - 10;  // Strong orange-red variation
-            gVar = (hash % 25) - 15;  // Less green variation
-            bVar = (hash % 15) - 10;  // Minimal blue
-            break;
-            
-        case MaterialType::GoldOre:
-            // Gold has shiny yellow with highlight sparkles
-            rVar = (hash % 30) - 10;  // Strong yellow-red
-            gVar = (hash % 30) - 15;  // Yellow-green
-            bVar = (hash % 10) - 8;   // Minimal blue
-            // Add shiny spots
-            if ((hash % 4) == 0) {
-                rVar += 30;
-                gVar += 20;
-            }
-            break;
-            
-        case MaterialType::CoalOre:
-            // Coal has dark with occasional shiny bits
-            rVar = gVar = bVar = (hash % 12) - 9;  // Generally dark
-            // Add occasional shiny anthracite highlights
-            if ((hash % 7) == 0) {
-                rVar += 15;
-                gVar += 15;
-                bVar += 15;
-            }
-            break;
-            
-        case MaterialType::DiamondOre:
-            // Diamond has blue-white sparkles in dark matrix
-            rVar = (hash % 20) - 10;
-            gVar = (hash % 25) - 10;
-            bVar = (hash % 35) - 10;  // More blue variation
-            // Add bright sparkles
-            if ((hash % 3) == 0) {
-                rVar += 30;
-                gVar += 40;
-                bVar += 50;
-            }
-            break;
-            
-        default:
-            // For any other materials, use moderate general variations
-            rVar = ((hash % 21) - 10);
-            gVar = ((hash >> 4) % 21) - 10;
-            bVar = ((hash >> 8) % 21) - 10;
-            break;
-    }
-    
-    // Apply color variation with proper clamping
-    int rInt = std::max(0, std::min(255, int(props.r) + rVar));
-    int gInt = std::max(0, std::min(255, int(props.g) + gVar));
-    int bInt = std::max(0, std::min(255, int(props.b) + bVar));
+    // The cell's shade from the material palette, the same one the world's pixels use
+    const MaterialColor color = MaterialPalette::color(material, x, y);
     
     // Convert to float in range [0, 1]
-    r = rInt / 255.0f;
-    g = gInt / 255.0f;
-    b = bInt / 255.0f;
+    r = color.r / 255.0f;
+    g = color.g / 255.0f;
+    b = color.b / 255.0f;
 }
 
 void Renderer::cleanup() {
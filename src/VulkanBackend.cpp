@@ -1551,13 +1551,13 @@ void VulkanBackend::drawMaterialRectangle(float x, float y, float width, float h
         return;
     }
     
-    // Get material properties from the materials database
-    const auto& props = MATERIAL_PROPERTIES[static_cast<size_t>(materialType)];
+    // Get the base colour from the material registry
+    const MaterialColor& color = MaterialRegistry::tables().color[static_cast<size_t>(materialType)];
     
     // Convert color from 0-255 to 0.0-1.0
-    float r = props.r / 255.0f;
-    float g = props.g / 255.0f;
-    float b = props.b / 255.0f;
+    float r = color.r / 255.0f;
+    float g = color.g / 255.0f;
+    float b = color.b / 255.0f;
     
     // Set the material in the current shader - this passes the material type to the shader
     if (m_currentShader) {
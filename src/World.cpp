@@ -3,23 +3,587 @@
 #include <iostream>
 #include <algorithm>
 #include <random>
+#include <queue>
 #include <SDL_stdinc.h>
 #include <cfloat> // For FLT_MAX
+#include <cstring>
+
+#if defined(__x86_64__) && (defined(__GNUC__) || defined(__clang__))
+#include <immintrin.h>
+#define PIXELPHYS_AVX2_POWDER_MASKS 1
+#endif
 
 namespace PixelPhys {
 
+namespace {
+
+// Salts that keep the independent random draws made for one cell in one tick apart
+enum RandomSalt : uint32_t {
+    SALT_POWDER_SIDE,
+    SALT_POWDER_KNOCK,
+    SALT_POWDER_ROW,        // Bitboard kernel: side bits for a whole 64-cell word
+    SALT_LIQUID_SIDE,
+    SALT_DECAY,
+    SALT_EXPLOSION,
+    SALT_REACTION           // + neighbour index 0..8
+};
+
+// Index of a neighbour offset in a 3x3 block, for per-neighbour salts
+inline uint32_t neighbourIndex(int dx, int dy) {
+    return static_cast<uint32_t>((dy + 1) * 3 + (dx + 1));
+}
+
+// Index of the lowest / highest set bit (bits must not be zero)
+inline int lowestBit(uint64_t bits) {
+#if defined(__GNUC__) || defined(__clang__)
+    return __builtin_ctzll(bits);
+#else
+    int index = 0;
+    while (!(bits & 1)) {
+        bits >>= 1;
+        ++index;
+    }
+    return index;
+#endif
+}
+
+inline int highestBit(uint64_t bits) {
+#if defined(__GNUC__) || defined(__clang__)
+    return 63 - __builtin_clzll(bits);
+#else
+    int index = 63;
+    while (!(bits >> 63)) {
+        bits <<= 1;
+        --index;
+    }
+    return index;
+#endif
+}
+
+// Movement class of a material: which step moves its cells
+enum class CellBehavior : uint8_t {
+    Static,     // Never moves on its own (empty, solids, grass stalks)
+    Powder,
+    Liquid,
+    Gas
+};
+
+// Per-material traits derived from the material tables, for the dispatch tables of the update
+struct MaterialTraits {
+    CellBehavior movement[static_cast<std::size_t>(MaterialType::COUNT)] = {};
+    
+    constexpr explicit MaterialTraits(const MaterialTables& materials) {
+        for (std::size_t i = 0; i < static_cast<std::size_t>(MaterialType::COUNT); ++i) {
+            const MaterialType material = static_cast<MaterialType>(i);
+            movement[i] = materials.is(material, MATERIAL_POWDER) ? CellBehavior::Powder
+                        : materials.is(material, MATERIAL_LIQUID) ? CellBehavior::Liquid
+                        : materials.is(material, MATERIAL_GAS)    ? CellBehavior::Gas
+                                                                  : CellBehavior::Static;
+        }
+    }
+    
+    CellBehavior movementOf(MaterialType material) const { return movement[static_cast<std::size_t>(material)]; }
+};
+
+// Which material sinks through which, built from the material densities: bit 'below' of row 'above' is set where a cell of 'above' trades
+// places with a cell of 'below' under it. Powders and liquids sink through lighter liquids
+// and gases, so liquids layer by density and gases bubble up through what lies on them.
+// Empty cells are not in the table; every step moves into them on its own. Rows hold 256
+// bits, one per possible MaterialType value.
+struct DisplacementTable {
+    static constexpr std::size_t COUNT = static_cast<std::size_t>(MaterialType::COUNT);
+    static_assert(COUNT <= 256, "displacement rows hold 256 materials");
+    
+    uint64_t rows[COUNT][4] = {};
+    
+    constexpr explicit DisplacementTable(const MaterialTables& materials) {
+        for (std::size_t above = 0; above < COUNT; ++above) {
+            if (!materials.is(static_cast<MaterialType>(above), MATERIAL_POWDER | MATERIAL_LIQUID)) continue;
+            
+            for (std::size_t below = 0; below < COUNT; ++below) {
+                if (materials.is(static_cast<MaterialType>(below), MATERIAL_LIQUID | MATERIAL_GAS) &&
+                    materials.density[above] > materials.density[below]) {
+                    rows[above][below / 64] |= uint64_t(1) << (below % 64);
+                }
+            }
+        }
+    }
+    
+    bool canDisplace(MaterialType above, MaterialType below) const {
+        const std::size_t bit = static_cast<std::size_t>(below);
+        return (rows[static_cast<std::size_t>(above)][bit / 64] >> (bit % 64)) & 1;
+    }
+};
+
+// Per-material flags used to build the powder bitboards without touching MaterialProperties
+constexpr uint8_t POWDER_FLAG = 1;
+constexpr uint8_t EMPTY_FLAG = 2;
+constexpr uint8_t FLUID_FLAG = 4;   // Liquids and gases, which heavier grains may sink through
+
+struct PowderFlagTable {
+    // 32 bits per entry, so the AVX2 mask builder can gather them
+    uint32_t flags[static_cast<std::size_t>(MaterialType::COUNT)] = {};
+    
+    constexpr explicit PowderFlagTable(const MaterialTables& materials) {
+        for (std::size_t i = 0; i < static_cast<std::size_t>(MaterialType::COUNT); ++i) {
+            const MaterialType material = static_cast<MaterialType>(i);
+            flags[i] = (materials.is(material, MATERIAL_POWDER) ? POWDER_FLAG : 0) |
+                       (material == MaterialType::Empty ? EMPTY_FLAG : 0) |
+                       (materials.is(material, MATERIAL_LIQUID | MATERIAL_GAS) ? FLUID_FLAG : 0);
+        }
+    }
+};
+// What a cell and one of its neighbours turn into when they react. The cell reacts on a
+// 1-in-'chance' roll per neighbour and update (1 always, 0 never).
+struct ReactionRule {
+    uint8_t chance = 0;
+    MaterialType product = MaterialType::Empty;           // The cell afterwards
+    MaterialType neighborProduct = MaterialType::Empty;   // The neighbour afterwards
+    uint8_t blast = 0;          // Radius around the cell that bursts into 'product' as well
+};
+
+// Material x material reaction table, built from the reactions and decay columns of the
+// registry. Row: the cell being updated, column: its neighbour.
+struct ReactionMatrix {
+    static constexpr std::size_t COUNT = static_cast<std::size_t>(MaterialType::COUNT);
+    
+    ReactionRule rules[COUNT][COUNT] = {};
+    MaterialDecay decay[COUNT] = {};
+    bool reactive[COUNT] = {};  // Has a rule or decays: the only cells the kernel visits
+    
+    constexpr explicit ReactionMatrix(const MaterialTables& materials) {
+        for (std::size_t i = 0; i < COUNT; ++i) {
+            const MaterialType material = static_cast<MaterialType>(i);
+            
+            // Last to first, so an earlier reaction wins a neighbour two of them match
+            for (std::size_t r = MaterialTables::MAX_REACTIONS; r-- > 0;) {
+                const MaterialReaction& reaction = materials.reactions[i][r];
+                if (reaction.chance == 0) continue;
+                
+                const ReactionRule rule{reaction.chance, reaction.product, reaction.neighborProduct, reaction.blast};
+                if (reaction.neighborFlags == 0) {
+                    add(material, reaction.neighbor, rule);
+                    continue;
+                }
+                for (std::size_t j = 0; j < COUNT; ++j) {
+                    const MaterialType neighbor = static_cast<MaterialType>(j);
+                    if ((materials.flags[j] & reaction.neighborFlags) == reaction.neighborFlags) {
+                        add(material, neighbor, rule);
+                    }
+                }
+            }
+            
+            if (materials.decay[i].percent != 0) {
+                decay[i] = materials.decay[i];
+                reactive[i] = true;
+            }
+        }
+    }
+    
+    constexpr void add(MaterialType cell, MaterialType neighbor, ReactionRule rule) {
+        rules[static_cast<std::size_t>(cell)][static_cast<std::size_t>(neighbor)] = rule;
+        reactive[static_cast<std::size_t>(cell)] = true;
+    }
+    
+    const ReactionRule& rule(MaterialType cell, MaterialType neighbor) const {
+        return rules[static_cast<std::size_t>(cell)][static_cast<std::size_t>(neighbor)];
+    }
+    const MaterialDecay& decayOf(MaterialType material) const { return decay[static_cast<std::size_t>(material)]; }
+    
+    // What a material is left as once everything it decays into has run out
+    MaterialType remainsOf(MaterialType material) const {
+        for (std::size_t step = 0; step < COUNT && decayOf(material).percent != 0; ++step) {
+            material = decayOf(material).product;
+        }
+        return material;
+    }
+};
+
+// The update's lookup tables. They are constant-initialized from the built-in materials, so
+// a run without a definition file builds nothing at startup, and are rebuilt from the
+// registry by Chunk::rebuildMaterialTables() when definitions are loaded.
+MaterialTraits g_materialTraits{BUILTIN_MATERIAL_TABLES};
+DisplacementTable g_displacement{BUILTIN_MATERIAL_TABLES};
+PowderFlagTable g_powderFlags{BUILTIN_MATERIAL_TABLES};
+ReactionMatrix g_reactions{BUILTIN_MATERIAL_TABLES};
+
+} // namespace
+
+std::array<bool, static_cast<std::size_t>(MaterialType::COUNT)> Chunk::s_reactiveMaterials = [] {
+    std::array<bool, static_cast<std::size_t>(MaterialType::COUNT)> reactive = {};
+    for (std::size_t i = 0; i < reactive.size(); ++i) {
+        reactive[i] = g_reactions.reactive[i];
+    }
+    return reactive;
+}();
+
+void Chunk::rebuildMaterialTables() {
+    const MaterialTables& materials = MaterialRegistry::tables();
+    g_materialTraits = MaterialTraits(materials);
+    g_displacement = DisplacementTable(materials);
+    g_powderFlags = PowderFlagTable(materials);
+    g_reactions = ReactionMatrix(materials);
+    for (std::size_t i = 0; i < s_reactiveMaterials.size(); ++i) {
+        s_reactiveMaterials[i] = g_reactions.reactive[i];
+    }
+}
+
 // Chunk implementation
 
 Chunk::Chunk(int posX, int posY) : m_posX(posX), m_posY(posY), m_isDirty(true), 
                                  m_shouldUpdateNextFrame(true), m_inactivityCounter(0) {
-    // Initialize chunk with empty cells
-    m_grid.resize(WIDTH * HEIGHT, MaterialType::Empty);
+    // Initialize chunk with empty cells (no cell is falling or has moved yet), walled in
+    // until a neighbour fills the halo
+    m_cells.resize(STRIDE * (HEIGHT + 2), Cell());
+    m_haloSnapshot.resize(HALO_CELLS);
+    m_runStarts.resize(STRIDE * COLUMN_WORDS, 0);
+    for (int x = -1; x <= WIDTH; ++x) {
+        rebuildRunStarts(x);
+    }
+    forEachHaloCell([this](int, int x, int y) {
+        m_cells[cellIndex(x, y)] = Cell(HALO_WALL);
+    });
     
     // Initialize pixel data for rendering (RGBA for each cell)
     m_pixelData.resize(WIDTH * HEIGHT * 4, 0);
     
-    // Initialize freeFalling status for each cell (none are falling initially)
-    m_isFreeFalling.resize(WIDTH * HEIGHT, false);
+    // Random draws until a world seed arrives
+    setRandomSeed(0);
+    
+    // A fresh chunk has to be scanned completely once
+    markAllDirty();
+}
+
+void Chunk::advanceMoveStamps() {
+    // Two stamps per update (falling/gas moves, then spreading moves). When the 7-bit
+    // counter runs out, clear the stamps once instead of snapshotting every update.
+    if (m_spreadStamp >= Cell::MAX_MOVE_STAMP - 1) {
+        for (Cell& cell : m_cells) {
+            cell.moveStamp = 0;
+        }
+        m_spreadStamp = 0;
+    }
+    m_fallStamp = m_spreadStamp + 1;
+    m_spreadStamp = m_fallStamp + 1;
+}
+
+void Chunk::markAllDirty() {
+    m_nextDirtyRect.include(0, 0);
+    m_nextDirtyRect.include(WIDTH - 1, HEIGHT - 1);
+    m_nextAwakeTiles.store(ALL_TILES, std::memory_order_relaxed);
+    m_nextRestlessTiles.store(ALL_TILES, std::memory_order_relaxed);
+    m_isDirty = true;
+}
+
+void Chunk::wakeTile(int tileX, int tileY) {
+    if (tileX < 0 || tileX >= TILES_X || tileY < 0 || tileY >= TILES_Y) {
+        return;
+    }
+    m_nextDirtyRect.include(tileX * TILE_SIZE, tileY * TILE_SIZE);
+    m_nextDirtyRect.include((tileX + 1) * TILE_SIZE - 1, (tileY + 1) * TILE_SIZE - 1);
+    const uint64_t tile = uint64_t(1) << (tileY * TILES_X + tileX);
+    m_nextAwakeTiles.fetch_or(tile, std::memory_order_relaxed);
+    m_nextRestlessTiles.fetch_or(tile, std::memory_order_relaxed);
+    m_isDirty.store(true, std::memory_order_relaxed);
+}
+
+void Chunk::wakeRect(int x0, int y0, int x1, int y1, bool drift) {
+    x0 = std::max(0, x0);
+    y0 = std::max(0, y0);
+    x1 = std::min(WIDTH - 1, x1);
+    y1 = std::min(HEIGHT - 1, y1);
+    if (x0 > x1 || y0 > y1) {
+        return;
+    }
+    m_nextDirtyRect.include(x0, y0);
+    m_nextDirtyRect.include(x1, y1);
+    
+    uint64_t tiles = 0;
+    for (int tileY = y0 / TILE_SIZE; tileY <= y1 / TILE_SIZE; ++tileY) {
+        for (int tileX = x0 / TILE_SIZE; tileX <= x1 / TILE_SIZE; ++tileX) {
+            tiles |= uint64_t(1) << (tileY * TILES_X + tileX);
+        }
+    }
+    m_nextAwakeTiles.fetch_or(tiles, std::memory_order_relaxed);
+    if (!drift) {
+        m_nextRestlessTiles.fetch_or(tiles, std::memory_order_relaxed);
+    }
+    m_isDirty.store(true, std::memory_order_relaxed);
+    setShouldUpdateNextFrame(true);
+}
+
+bool Chunk::settle() {
+    bool moved = false;
+    std::vector<Cell> sunk;
+    std::vector<Cell> risen;
+    for (int x = 0; x < WIDTH; ++x) {
+        // Whatever decays runs out while the chunk rests, so fire burns out instead of
+        // being kept until the player returns
+        bool columnMoved = false;
+        for (int y = 0; y < HEIGHT; ++y) {
+            Cell& cell = m_cells[cellIndex(x, y)];
+            const MaterialType remains = g_reactions.remainsOf(cell.material);
+            if (remains != cell.material) {
+                trackReactive(cell.material, remains);
+                cell = Cell(remains);
+                markPixelChanged(x, y);
+                columnMoved = true;
+            }
+        }
+        
+        // Static cells (and the chunk's top and bottom) split the column into spans that
+        // settle on their own
+        int bottom = HEIGHT - 1;
+        for (int y = HEIGHT - 1; y >= -1; --y) {
+            if (y >= 0) {
+                const MaterialType material = m_cells[cellIndex(x, y)].material;
+                if (material == MaterialType::Empty || g_materialTraits.movementOf(material) != CellBehavior::Static) {
+                    continue;
+                }
+            }
+            if (y + 1 <= bottom) {
+                columnMoved |= settleSpan(x, y + 1, bottom, sunk, risen);
+            }
+            bottom = y - 1;
+        }
+        
+        if (columnMoved) {
+            rebuildRunStarts(x);
+            moved = true;
+        }
+    }
+    
+    // At rest: nothing left to simulate
+    m_nextDirtyRect.reset();
+    m_nextAwakeTiles.store(0, std::memory_order_relaxed);
+    m_nextRestlessTiles.store(0, std::memory_order_relaxed);
+    m_isDirty.store(false, std::memory_order_relaxed);
+    setShouldUpdateNextFrame(false);
+    
+    if (moved) {
+        m_isModified.store(true, std::memory_order_relaxed);
+        updateChangedPixels();
+    }
+    return moved;
+}
+
+bool Chunk::settleSpan(int x, int top, int bottom, std::vector<Cell>& sunk, std::vector<Cell>& risen) {
+    // Bottom-up, powders and liquids pile onto the bottom of the span. Each one sinks through
+    // the cells already piled below it for as long as the update would let it displace them
+    // (g_displacement: lighter liquids), so sand ends up under water and oil over it. Gases
+    // are lifted out first and collect under the top of the span, in their order.
+    sunk.clear();
+    risen.clear();
+    for (int y = bottom; y >= top; --y) {
+        const Cell& cell = m_cells[cellIndex(x, y)];
+        switch (g_materialTraits.movementOf(cell.material)) {
+            case CellBehavior::Powder:
+            case CellBehavior::Liquid: {
+                auto slot = sunk.end();
+                while (slot != sunk.begin() && g_displacement.canDisplace(cell.material, (slot - 1)->material)) {
+                    --slot;
+                }
+                sunk.insert(slot, Cell(cell.material));
+                break;
+            }
+            case CellBehavior::Gas:
+                risen.push_back(cell);
+                break;
+            default:
+                break;
+        }
+    }
+    
+    bool moved = false;
+    auto place = [&](int y, const Cell& cell) {
+        Cell& target = m_cells[cellIndex(x, y)];
+        if (target.material != cell.material) {
+            target = cell;
+            markPixelChanged(x, y);
+            moved = true;
+        }
+    };
+    int y = bottom;
+    for (const Cell& cell : sunk) {
+        place(y--, cell);
+    }
+    const int gasBottom = top + static_cast<int>(risen.size()) - 1;
+    for (; y > gasBottom; --y) {
+        place(y, Cell());
+    }
+    // 'risen' runs bottom-up, so its last gas goes to the top
+    for (const Cell& cell : risen) {
+        place(y--, cell);
+    }
+    return moved;
+}
+
+uint64_t Chunk::dropSleepingTiles(uint64_t woken, uint64_t restless) {
+    uint64_t awake = woken;
+    for (uint64_t bits = woken; bits != 0; bits &= bits - 1) {
+        const int tile = lowestBit(bits);
+        uint8_t& calm = m_tileCalmUpdates[tile];
+        if ((restless >> tile) & 1) {
+            calm = 0;
+        } else if (calm < TILE_SLEEP_UPDATES) {
+            ++calm;
+        } else {
+            awake &= ~(uint64_t(1) << tile);
+        }
+    }
+    return awake;
+}
+
+void Chunk::syncHalo(const ChunkNeighbors& neighbors) {
+    forEachHaloCell([&](int i, int x, int y) {
+        const int dx = (x < 0) ? -1 : (x >= WIDTH ? 1 : 0);
+        const int dy = (y < 0) ? -1 : (y >= HEIGHT ? 1 : 0);
+        const Chunk* neighbor = neighbors.at(dx, dy);
+        
+        Cell& halo = m_cells[cellIndex(x, y)];
+        const MaterialType before = halo.material;
+        if (neighbor) {
+            halo = neighbor->m_cells[cellIndex(x - dx * WIDTH, y - dy * HEIGHT)];
+            halo.moveStamp = 0;   // The neighbour's stamps mean nothing to this update
+        } else {
+            halo = Cell(HALO_WALL);
+        }
+        trackReactive(before, halo.material);
+        m_haloSnapshot[i] = halo;
+    });
+    
+    // The side halo columns hold whole neighbour columns: rebuild their depth field
+    rebuildRunStarts(-1);
+    rebuildRunStarts(WIDTH);
+}
+
+void Chunk::updateRunStart(int x, int y) {
+    // Only liquid rows are ever read (a lookup starts at a liquid cell and stops at the first
+    // start above it), so powder and gas moves skip the bit work entirely
+    const MaterialType material = m_cells[cellIndex(x, y)].material;
+    if (!MaterialRegistry::tables().is(material, MATERIAL_LIQUID)) {
+        return;
+    }
+    const bool start = (y == 0) || material != m_cells[cellIndex(x, y - 1)].material;
+    uint64_t& word = m_runStarts[(x + 1) * COLUMN_WORDS + y / 64];
+    const uint64_t bit = uint64_t(1) << (y % 64);
+    word = start ? (word | bit) : (word & ~bit);
+}
+
+void Chunk::cellChanged(int idx) {
+    const int x = idx % STRIDE - 1;
+    const int y = idx / STRIDE - 1;
+    // Halo rows -1 and HEIGHT have no bits (row 0 always starts a run); halo cells have no pixels
+    if (y >= 0 && y < HEIGHT) {
+        updateRunStart(x, y);
+        if (x >= 0 && x < WIDTH) {
+            markPixelChanged(x, y);
+        }
+    }
+    if (y + 1 > 0 && y + 1 < HEIGHT) {
+        updateRunStart(x, y + 1);
+    }
+}
+
+void Chunk::rebuildRunStarts(int x) {
+    for (int y = 0; y < HEIGHT; ++y) {
+        updateRunStart(x, y);
+    }
+}
+
+int Chunk::fallDistance(int idx, int y, int speed) const {
+    // The march may end in the halo row; the neighbour below carries the cell on from there
+    const int limit = std::min(speed, HEIGHT - y);
+    int distance = 1;
+    while (distance < limit && m_cells[idx + (distance + 1) * STRIDE].material == MaterialType::Empty) {
+        ++distance;
+    }
+    return distance;
+}
+
+int Chunk::runHeight(int x, int y) const {
+    // Nearest run start at or above row y; row 0 always is one
+    const uint64_t* column = &m_runStarts[(x + 1) * COLUMN_WORDS];
+    int word = y / 64;
+    uint64_t bits = column[word] & (~uint64_t(0) >> (63 - y % 64));
+    while (bits == 0) {
+        bits = column[--word];
+    }
+    return y - (word * 64 + highestBit(bits)) + 1;
+}
+
+void Chunk::flushHalo(const ChunkNeighbors& neighbors) {
+    // Halo cells the passes changed now belong to the neighbours. Chunks of one scheduler
+    // phase are two chunks apart, so no two of them write the same neighbour cell.
+    const uint64_t restlessTiles = m_nextRestlessTiles.load(std::memory_order_relaxed);
+    forEachHaloCell([&](int i, int x, int y) {
+        const Cell& halo = m_cells[cellIndex(x, y)];
+        const Cell& before = m_haloSnapshot[i];
+        if (halo.material == before.material && halo.freeFalling == before.freeFalling &&
+            halo.velocity == before.velocity && halo.life == before.life) {
+            return;
+        }
+        const int dx = (x < 0) ? -1 : (x >= WIDTH ? 1 : 0);
+        const int dy = (y < 0) ? -1 : (y >= HEIGHT ? 1 : 0);
+        if (Chunk* neighbor = neighbors.at(dx, dy)) {
+            // The cell came from the tile beside it: if that tile only drifted, so did the cell
+            const uint64_t source = tileBit(std::clamp(x, 0, WIDTH - 1), std::clamp(y, 0, HEIGHT - 1));
+            const bool drift = !(restlessTiles & source);
+            neighbor->receiveHaloCell(x - dx * WIDTH, y - dy * HEIGHT, halo, drift);
+        }
+    });
+    
+    // Our edge cells are the neighbours' halo: where they changed, the neighbours' cells
+    // next to them may be able to move now
+    const DirtyRect active = m_nextDirtyRect.load();
+    if (active.isEmpty()) {
+        return;
+    }
+    const uint64_t activeTiles = getNextAwakeTiles();
+    for (int dy = -1; dy <= 1; ++dy) {
+        for (int dx = -1; dx <= 1; ++dx) {
+            Chunk* neighbor = neighbors.at(dx, dy);
+            if (!neighbor || (dx == 0 && dy == 0)) {
+                continue;
+            }
+            
+            // Our cells that the neighbour sees through its halo, limited to the activity
+            const int x0 = std::max(active.minX, dx > 0 ? WIDTH - 1 : 0);
+            const int x1 = std::min(active.maxX, dx < 0 ? 0 : WIDTH - 1);
+            const int y0 = std::max(active.minY, dy > 0 ? HEIGHT - 1 : 0);
+            const int y1 = std::min(active.maxY, dy < 0 ? 0 : HEIGHT - 1);
+            
+            // Wake the neighbour's cells beside each awake tile along that band
+            for (int tileY = y0 / TILE_SIZE; y0 <= y1 && tileY <= y1 / TILE_SIZE; ++tileY) {
+                for (int tileX = x0 / TILE_SIZE; x0 <= x1 && tileX <= x1 / TILE_SIZE; ++tileX) {
+                    const uint64_t tile = uint64_t(1) << (tileY * TILES_X + tileX);
+                    if (!(activeTiles & tile)) {
+                        continue;
+                    }
+                    const int sx0 = std::max(x0, tileX * TILE_SIZE) - dx * WIDTH;
+                    const int sx1 = std::min(x1, tileX * TILE_SIZE + TILE_SIZE - 1) - dx * WIDTH;
+                    const int sy0 = std::max(y0, tileY * TILE_SIZE) - dy * HEIGHT;
+                    const int sy1 = std::min(y1, tileY * TILE_SIZE + TILE_SIZE - 1) - dy * HEIGHT;
+                    neighbor->wakeRect(sx0 - 1, sy0 - 1, sx1 + 1, sy1 + 1, !(restlessTiles & tile));
+                }
+            }
+        }
+    }
+}
+
+void Chunk::receiveHaloCell(int x, int y, const Cell& cell, bool drift) {
+    Cell& target = m_cells[cellIndex(x, y)];
+    trackReactive(target.material, cell.material);
+    target = cell;
+    target.moveStamp = 0;
+    // Safe without atomics: chunks of one phase only write edge cells of this chunk whose
+    // run-start words differ (rows 0-1 and row HEIGHT-1, columns 0 and WIDTH-1), and whose
+    // changed-pixel words differ (corner tiles, or the tiles of opposite edges)
+    cellChanged(cellIndex(x, y));
+    markCellDirty(x, y, drift);
+    m_isDirty.store(true, std::memory_order_relaxed);
+    setShouldUpdateNextFrame(true);
+    m_isModified.store(true, std::memory_order_relaxed);
 }
 
 MaterialType Chunk::get(int x, int y) const {
@@ -27,14 +591,14 @@ MaterialType Chunk::get(int x, int y) const {
         return MaterialType::Empty;
     }
     // Position-based material access for pixel-perfect alignment
-    int idx = y * WIDTH + x;
+    int idx = cellIndex(x, y);
     
     // Make absolutely sure we're in bounds
-    if (idx < 0 || idx >= static_cast<int>(m_grid.size())) {
+    if (idx < 0 || idx >= static_cast<int>(m_cells.size())) {
         return MaterialType::Empty;
     }
     
-    return m_grid[idx];
+    return m_cells[idx].material;
 }
 
 void Chunk::set(int x, int y, MaterialType material) {
@@ -43,1424 +607,1136 @@ void Chunk::set(int x, int y, MaterialType material) {
     }
     
     // Position-based material access for pixel-perfect alignment
-    int idx = y * WIDTH + x;
+    int idx = cellIndex(x, y);
     
     // Make absolutely sure we're in bounds
-    if (idx < 0 || idx >= static_cast<int>(m_grid.size())) {
+    if (idx < 0 || idx >= static_cast<int>(m_cells.size())) {
         return;
     }
     
-    MaterialType oldMaterial = m_grid[idx];
+    MaterialType oldMaterial = m_cells[idx].material;
     if (oldMaterial != material) {
-        // Only update material type
-        m_grid[idx] = material;
-        m_isDirty = true;
+        // A new material starts with fresh cell state
+        writeCell(idx, Cell(material));
+        m_isDirty.store(true, std::memory_order_relaxed);
+        markCellDirty(x, y);
         
         // Mark the chunk as modified
-        m_isModified = true;
+        m_isModified.store(true, std::memory_order_relaxed);
+    }
+}
+
+void Chunk::Editor::set(int x, int y, MaterialType material) {
+    Cell& cell = m_chunk.m_cells[cellIndex(x, y)];
+    if (cell.material != material) {
+        m_chunk.trackReactive(cell.material, material);
+        cell = Cell(material);
+        m_chunk.markPixelChanged(x, y);
+        m_edited.include(x, y);
+    }
+}
+
+void Chunk::Editor::fillSpan(int x0, int x1, int y, MaterialType material) {
+    x0 = std::max(0, x0);
+    x1 = std::min(WIDTH - 1, x1);
+    if (x0 > x1 || y < 0 || y >= HEIGHT) {
+        return;
+    }
+    // A row of the grid is contiguous, halo columns aside
+    Cell* row = &m_chunk.m_cells[cellIndex(0, y)];
+    for (int x = x0; x <= x1; ++x) {
+        m_chunk.trackReactive(row[x].material, material);
+    }
+    std::fill(row + x0, row + x1 + 1, Cell(material));
+    m_chunk.markPixelsChanged(x0, y, x1);
+    m_edited.include(x0, y);
+    m_edited.include(x1, y);
+}
+
+void Chunk::Editor::commit() {
+    if (m_edited.isEmpty()) {
+        return;
+    }
+    // Each bit depends on the cell and the one above it, so the row below the edit changes too
+    const int lastRow = std::min(HEIGHT - 1, m_edited.maxY + 1);
+    for (int x = m_edited.minX; x <= m_edited.maxX; ++x) {
+        for (int y = m_edited.minY; y <= lastRow; ++y) {
+            m_chunk.updateRunStart(x, y);
+        }
+    }
+    
+    m_chunk.wakeRect(m_edited.minX - 1, m_edited.minY - 1, m_edited.maxX + 1, m_edited.maxY + 1);
+    m_chunk.m_isModified.store(true, std::memory_order_relaxed);
+    m_edited.reset();
+}
+
+// Policies of the single-class sweeps: the class a sweep moves, its direction and which
+// cells it passes over
+struct Chunk::PowderPolicy {
+    static constexpr CellBehavior BEHAVIOR = CellBehavior::Powder;
+    // Bottom-to-top, right-to-left for natural falling behaviour
+    static constexpr bool TOP_DOWN = false;
+    static constexpr bool RIGHT_TO_LEFT = true;
+    // Moves only ever go downward, so the row being swept still holds its start-of-update state
+    static bool done(const Chunk&, const Cell&) { return false; }
+    static void step(Chunk& chunk, int x, int y, bool& moved) { chunk.stepPowder(x, y, moved); }
+};
+
+struct Chunk::LiquidFallPolicy {
+    static constexpr CellBehavior BEHAVIOR = CellBehavior::Liquid;
+    // Bottom-to-top so liquids fall into cells vacated this update
+    static constexpr bool TOP_DOWN = false;
+    static constexpr bool RIGHT_TO_LEFT = false;
+    static bool done(const Chunk& chunk, const Cell& cell) { return cell.moveStamp == chunk.m_fallStamp; }
+    static void step(Chunk& chunk, int x, int y, bool& moved) { chunk.stepLiquidFall(x, y, moved); }
+};
+
+struct Chunk::GasPolicy {
+    static constexpr CellBehavior BEHAVIOR = CellBehavior::Gas;
+    // Top-to-bottom, so a gas rises into the cell the one above it just left
+    static constexpr bool TOP_DOWN = true;
+    static constexpr bool RIGHT_TO_LEFT = false;
+    static bool done(const Chunk& chunk, const Cell& cell) {
+        return cell.moveStamp == chunk.m_fallStamp || cell.moveStamp == chunk.m_spreadStamp;
+    }
+    static void step(Chunk& chunk, int x, int y, bool& moved) { chunk.stepGas(x, y, moved); }
+};
+
+template <typename Policy>
+void Chunk::sweepCells(bool& anyMaterialMoved) {
+    const int minX = m_dirtyRect.minX;
+    const int maxX = m_dirtyRect.maxX;
+    const int minY = m_dirtyRect.minY;
+    const int maxY = m_dirtyRect.maxY;
+    
+    for (int row = 0; row <= maxY - minY; ++row) {
+        const int y = Policy::TOP_DOWN ? minY + row : maxY - row;
+        const uint32_t rowTiles = tileRowMask(m_awakeTiles, y);
+        if (rowTiles == 0) continue;
+        
+        for (int col = 0; col <= maxX - minX; ++col) {
+            const int x = Policy::RIGHT_TO_LEFT ? maxX - col : minX + col;
+            if (!isTileAwake(rowTiles, x)) {
+                // Skip the rest of this sleeping tile in the sweep direction
+                const int edge = Policy::RIGHT_TO_LEFT ? (x & ~(TILE_SIZE - 1)) : (x | (TILE_SIZE - 1));
+                col = Policy::RIGHT_TO_LEFT ? maxX - edge : edge - minX;
+                continue;
+            }
+            
+            // One table lookup rejects every cell of another class
+            const Cell& cell = m_cells[cellIndex(x, y)];
+            if (g_materialTraits.movementOf(cell.material) != Policy::BEHAVIOR || Policy::done(*this, cell)) {
+                continue;
+            }
+            Policy::step(*this, x, y, anyMaterialMoved);
+        }
     }
 }
 
-void Chunk::update(Chunk* chunkBelow, Chunk* chunkLeft, Chunk* chunkRight) {
+bool Chunk::beginUpdate() {
     // At the start of each frame, assume this chunk won't need processing next frame
     setShouldUpdateNextFrame(false);
     
     // If this chunk isn't marked as dirty, skip updating it entirely
     if (!m_isDirty) {
         m_inactivityCounter++;
-        return;
+        return false;
+    }
+    
+    // Only scan the cells that changed (or neighbour a change) since the last update
+    m_dirtyRect = m_nextDirtyRect.load();
+    m_nextDirtyRect.reset();
+    m_awakeTiles = dropSleepingTiles(m_nextAwakeTiles.exchange(0, std::memory_order_relaxed),
+                                     m_nextRestlessTiles.exchange(0, std::memory_order_relaxed));
+    if (m_dirtyRect.isEmpty() || m_awakeTiles == 0) {
+        // Flagged dirty but nothing can move - counts as an inactive frame
+        m_isDirty = false;
+        m_inactivityCounter++;
+        return false;
+    }
+    
+    // Reset inactivity counter since we're updating this frame
+    m_inactivityCounter = 0;
+    return true;
+}
+
+void Chunk::updatePowderPass(bool& anyMaterialMoved) {
+    if (s_powderKernel == PowderKernel::Bitboard) {
+        updatePowdersBitboard(anyMaterialMoved);
     } else {
-        // Reset inactivity counter since we're updating this frame
-        m_inactivityCounter = 0;
+        sweepCells<PowderPolicy>(anyMaterialMoved);
+    }
+}
+
+void Chunk::updatePowders() {
+    if (!beginUpdate()) {
+        return;
+    }
+    advanceMoveStamps();
+    ++m_tick;
+    
+    bool anyMaterialMoved = false;
+    updatePowderPass(anyMaterialMoved);
+    setShouldUpdateNextFrame(anyMaterialMoved || !m_nextDirtyRect.isEmpty());
+    m_isDirty = false;
+}
+
+void Chunk::update(const ChunkNeighbors& neighbors) {
+    if (!beginUpdate()) {
+        return;
     }
     
-    // Create a copy of the grid for processing (to avoid updating cells already processed this frame)
-    std::vector<MaterialType> oldGrid = m_grid;
+    // Mirror the neighbours' edge cells, so every pass can read and move one cell past the edge
+    syncHalo(neighbors);
+    
+    // Fresh move stamps for this update: cells written by a move are skipped by later
+    // passes instead of comparing against a snapshot copy of the whole grid
+    advanceMoveStamps();
+    ++m_tick;
     
     // Flag to track if any materials moved during this update
     bool anyMaterialMoved = false;
     
-    // First handle powders (falling materials like sand, gravel)
-    // Process bottom-to-top, right-to-left to ensure natural falling behavior
-    for (int y = HEIGHT - 1; y >= 0; --y) {
-        for (int x = WIDTH - 1; x >= 0; --x) {
-            int idx = y * WIDTH + x;
-            MaterialType material = oldGrid[idx];
+    if (s_updateMode == UpdateMode::Fused) {
+        updateFused(anyMaterialMoved);
+    } else {
+        // First handle powders (falling materials like sand, gravel)
+        updatePowderPass(anyMaterialMoved);
+        
+        // Now handle liquids - falling first, then horizontal spreading
+        sweepCells<LiquidFallPolicy>(anyMaterialMoved);
+        updateLiquidSpreading(anyMaterialMoved);
+        
+        // Handle gas rise (for fire, flammable gas, etc.)
+        sweepCells<GasPolicy>(anyMaterialMoved);
+        
+        // Handle material interactions (like fire spreading, water effects, etc.)
+        handleMaterialInteractions(anyMaterialMoved);
+    }
+    
+    // Hand the cells that moved into the halo over to the neighbours
+    flushHalo(neighbors);
+    
+    // Mark the chunk for update next frame if materials moved
+    // This allows materials to continue being simulated even without player interaction
+    if (anyMaterialMoved) {
+        setShouldUpdateNextFrame(true);
+    } else if (!m_nextDirtyRect.isEmpty()) {
+        // Still-burning cells keep the chunk alive even when nothing moved
+        setShouldUpdateNextFrame(true);
+    }
+    
+    // Recolour the cells this update wrote, and those neighbours handed over since the last one
+    updateChangedPixels();
+    m_isDirty = false;
+}
+
+void Chunk::stepLiquidFall(int x, int y, bool& anyMaterialMoved) {
+    // Row HEIGHT is the halo, so the cells below always exist; moves into it are
+    // handed to the neighbour when the update flushes the halo
+    int idx = cellIndex(x, y);
+    MaterialType material = m_cells[idx].material;
+    
+    // Check directly below - liquids may displace what's below them
+    int belowIdx = idx + STRIDE;
+    MaterialType belowMaterial = m_cells[belowIdx].material;
+    if (belowMaterial == MaterialType::Empty) {
+        // Free fall: pick up speed and drop through as many empty cells
+        const int speed = std::min(m_cells[idx].velocity + 1, Physics::MAX_FALL_SPEED);
+        const int distance = fallDistance(idx, y, speed);
+        moveCell(idx, idx + distance * STRIDE, m_fallStamp);
+        m_cells[idx + distance * STRIDE].velocity = static_cast<int8_t>(speed);
+        anyMaterialMoved = true;
+        markCellDirty(x, y);
+        markCellDirty(x, y + distance);
+        return;
+    }
+    
+    // Anything else stops the fall
+    m_cells[idx].velocity = 0;
+    if (g_displacement.canDisplace(material, belowMaterial)) {
+        // Sink through a lighter liquid or gas, which rises into our place
+        swapCells(idx, belowIdx, m_fallStamp);
+        anyMaterialMoved = true;
+        markCellDirty(x, y);
+        return;
+    }
+    
+    // If can't move down, try diagonal
+    if (belowMaterial != MaterialType::Empty) {
+        // Randomly choose which side to try first
+        bool tryLeftFirst = (random(x, y, SALT_LIQUID_SIDE) % 2 == 0);
+        int firstIdx = belowIdx + (tryLeftFirst ? -1 : 1);
+        int secondIdx = belowIdx + (tryLeftFirst ? 1 : -1);
+        
+        for (int targetIdx : {firstIdx, secondIdx}) {
+            if (m_cells[targetIdx].material == MaterialType::Empty) {
+                moveCell(idx, targetIdx, m_fallStamp);
+                anyMaterialMoved = true;
+                markCellDirty(x, y);
+                return;
+            }
+        }
+    }
+}
+
+void Chunk::updateLiquidSpreading(bool& anyMaterialMoved) {
+    const int minX = m_dirtyRect.minX;
+    const int maxX = m_dirtyRect.maxX;
+    const int minY = m_dirtyRect.minY;
+    const int maxY = m_dirtyRect.maxY;
+    
+    // Liquids that already fell this update may still spread; ones moved by spreading may not
+    
+    // Process liquids from bottom to top
+    for (int y = maxY; y >= minY; --y) {
+        const uint32_t rowTiles = tileRowMask(m_awakeTiles, y);
+        if (rowTiles == 0) continue;
+        
+        // Use alternating directions for balanced spreading
+        for (int iteration = 0; iteration < 2; ++iteration) {
+            bool leftToRight = (iteration == 0);
             
-            // Skip empty cells
-            if (material == MaterialType::Empty) {
-                continue;
+            for (int i = minX; i <= maxX; ++i) {
+                int x = leftToRight ? i : (maxX - (i - minX));
+                if (!isTileAwake(rowTiles, x)) {
+                    // Skip to the far edge of this sleeping tile in the current direction
+                    int edge = leftToRight ? (x | (TILE_SIZE - 1)) : (x & ~(TILE_SIZE - 1));
+                    i = leftToRight ? edge : (maxX - (edge - minX));
+                    continue;
+                }
+                
+                int idx = cellIndex(x, y);
+                
+                // Skip cells that aren't liquids or were already processed
+                MaterialType material = m_cells[idx].material;
+                if (material == MaterialType::Empty || m_cells[idx].moveStamp == m_spreadStamp) {
+                    continue;
+                }
+                
+                if (MaterialRegistry::tables().is(material, MATERIAL_LIQUID)) {
+                    stepLiquidSpread(x, y, leftToRight, anyMaterialMoved);
+                }
+            }
+        }
+    }
+}
+
+void Chunk::stepLiquidSpread(int x, int y, bool leftToRight, bool& anyMaterialMoved) {
+    int idx = cellIndex(x, y);
+    MaterialType material = m_cells[idx].material;
+    const MaterialTables& materials = MaterialRegistry::tables();
+    
+    // Check if there's a fluid cell directly below (the halo row below the last one included)
+    MaterialType belowMaterial = m_cells[idx + STRIDE].material;
+    bool hasLiquidBelow = (belowMaterial == material); // Same liquid type below
+    bool hasEmptyBelow = (belowMaterial == MaterialType::Empty);
+    
+    // ONLY spread horizontally if:
+    // 1. We can't fall downward (blocked by something that's not empty)
+    // 2. OR we have same liquid below us (part of a water column)
+    if (!hasEmptyBelow || hasLiquidBelow) {
+        // Look for water level discrepancies: height of the fluid column at current position
+        int liquidColumnHeight = runHeight(x, y);
+    
+        // Set spread direction based on iteration
+        int spreadDirection = leftToRight ? 1 : -1;
+    
+        // Get material-specific dispersal rate from the material tables
+        int dispersalRate = materials.dispersal[static_cast<std::size_t>(material)];
+    
+        // Higher liquid columns create more pressure (further spreading)
+        int liquidPressure = std::min(dispersalRate + (liquidColumnHeight / 2), 8);
+    
+        // Search for empty spaces or lower liquid columns to flow to
+        for (int spread = 1; spread <= liquidPressure; ++spread) {
+            int nx = x + (spreadDirection * spread);
+            
+            // Liquid may flow one cell into the halo; the neighbour carries it further
+            if (nx < -1 || nx > WIDTH) {
+                break;
             }
+            int sideIdx = cellIndex(nx, y);
+            MaterialType sideNeighbor = m_cells[sideIdx].material;
+        
+            // If we hit same liquid, check column height
+            if (sideNeighbor == material) {
+                int sideColumnHeight = runHeight(nx, y);
             
-            const auto& props = MAT_PROPS(material);
+                // If this column is higher, continue searching outward
+                if (liquidColumnHeight <= sideColumnHeight) {
+                    continue;
+                }
             
-            // Handle powders (like sand)
-            if (props.isPowder) {
-                // Always assume powders are falling - simulate continuous motion without requiring clicks
-                bool isFalling = true;
-                // Keep track of whether this material is currently moving
-                m_isFreeFalling[idx] = true;
-                
-                // Try to move powder down
-                if (y < HEIGHT - 1) {
-                    // Check directly below
-                    int belowIdx = (y + 1) * WIDTH + x;
-                    MaterialType belowMaterial = (belowIdx < static_cast<int>(m_grid.size())) ? 
-                                                m_grid[belowIdx] : MaterialType::Empty;
-                    
-                    // If below is out of chunk, check the chunk below
-                    if (y == HEIGHT - 1 && chunkBelow) {
-                        belowMaterial = chunkBelow->get(x, 0);
-                        
-                        // If below is empty, move down
-                        if (belowMaterial == MaterialType::Empty) {
-                            // Move directly to empty space below
-                            chunkBelow->set(x, 0, material);
-                            m_grid[idx] = MaterialType::Empty;
-                            anyMaterialMoved = true;
-                            
-                            // Mark the particle as falling in the other chunk
-                            chunkBelow->setFreeFalling(x, true);
-                            
-                            // Mark the chunk below as needing update next frame
-                            chunkBelow->setShouldUpdateNextFrame(true);
-                            continue;
-                        } 
-                        // If we can't move down, check diagonally - always try to move diagonally for better flow
-                        else {
-                            bool moved = false;
-                            
-                            // Try diagonal movement - first pick a random side to check
-                            bool checkLeftFirst = (m_rng() % 2 == 0);
-                            
-                            // Check down-left
-                            if (checkLeftFirst && x > 0) {
-                                MaterialType downLeftMaterial = chunkBelow->get(x - 1, 0);
-                                if (downLeftMaterial == MaterialType::Empty) {
-                                    chunkBelow->set(x - 1, 0, material);
-                                    m_grid[idx] = MaterialType::Empty;
-                                    chunkBelow->m_isFreeFalling[x - 1] = true;
-                                    anyMaterialMoved = true;
-                                    chunkBelow->setShouldUpdateNextFrame(true);
-                                    moved = true;
-                                }
-                            }
-                            
-                            // Check down-right if didn't move left
-                            if (!moved && x < WIDTH - 1) {
-                                MaterialType downRightMaterial = chunkBelow->get(x + 1, 0);
-                                if (downRightMaterial == MaterialType::Empty) {
-                                    chunkBelow->set(x + 1, 0, material);
-                                    m_grid[idx] = MaterialType::Empty;
-                                    chunkBelow->m_isFreeFalling[x + 1] = true;
-                                    anyMaterialMoved = true;
-                                    chunkBelow->setShouldUpdateNextFrame(true);
-                                    moved = true;
-                                }
-                            }
-                            
-                            // If not already moved and we need to check the right first
-                            if (!moved && !checkLeftFirst && x > 0) {
-                                MaterialType downLeftMaterial = chunkBelow->get(x - 1, 0);
-                                if (downLeftMaterial == MaterialType::Empty) {
-                                    chunkBelow->set(x - 1, 0, material);
-                                    m_grid[idx] = MaterialType::Empty;
-                                    chunkBelow->m_isFreeFalling[x - 1] = true;
-                                    anyMaterialMoved = true;
-                                    chunkBelow->setShouldUpdateNextFrame(true);
-                                    moved = true;
-                                }
-                            }
-                            
-                            if (moved) {
-                                continue;
-                            }
-                        }
-                        
-                        // Always mark the chunk below as needing update next frame
-                        chunkBelow->setShouldUpdateNextFrame(true);
-                    }
-                    // Handle within the same chunk
-                    else if (belowMaterial == MaterialType::Empty) {
-                        // Move powder straight down
-                        m_grid[belowIdx] = material;
-                        m_grid[idx] = MaterialType::Empty;
+                // If current column is significantly higher, try to level it out by moving
+                // the top of this column onto the lower one
+                if (liquidColumnHeight > sideColumnHeight + 1) {
+                    int topY = y - sideColumnHeight;
+                    int topIdx = cellIndex(nx, topY);
+                    if (m_cells[topIdx].material == MaterialType::Empty) {
+                        moveCell(idx, topIdx, m_spreadStamp);
                         anyMaterialMoved = true;
-                        
-                        // Mark the particle as free-falling
-                        m_isFreeFalling[belowIdx] = true;
-                        continue; // Done moving this particle
-                    }
-                    // Handle diagonal movement - always attempt for continual flow
-                    else {
-                        bool movedDiagonally = false;
-                        
-                        // Randomly choose which side to check first for more natural behavior
-                        bool checkLeftFirst = (m_rng() % 2 == 0);
-                        
-                        // Try moving down-left or down-right
-                        if (checkLeftFirst) {
-                            // Try down-left if possible
-                            if (x > 0) {
-                                int downLeftIdx = (y + 1) * WIDTH + (x - 1);
-                                MaterialType downLeftMaterial = MaterialType::Empty;
-                                
-                                // Handle cross-chunk boundaries if needed
-                                if (x == 0 && y == HEIGHT - 1 && chunkBelow && chunkLeft) {
-                                    downLeftMaterial = chunkBelow->get(WIDTH - 1, 0);
-                                } else if (x == 0 && chunkLeft) {
-                                    downLeftMaterial = chunkLeft->get(WIDTH - 1, y + 1);
-                                } else if (y == HEIGHT - 1 && chunkBelow) {
-                                    downLeftMaterial = chunkBelow->get(x - 1, 0);
-                                } else if (downLeftIdx < static_cast<int>(m_grid.size())) {
-                                    downLeftMaterial = m_grid[downLeftIdx];
-                                }
-                                
-                                if (downLeftMaterial == MaterialType::Empty) {
-                                    // Handle cross-chunk boundaries
-                                    if (x == 0 && y == HEIGHT - 1 && chunkBelow && chunkLeft) {
-                                        chunkBelow->set(WIDTH - 1, 0, material);
-                                        chunkBelow->m_isFreeFalling[WIDTH * 0 + WIDTH - 1] = true;
-                                        chunkBelow->setShouldUpdateNextFrame(true);
-                                    } else if (x == 0 && chunkLeft) {
-                                        chunkLeft->set(WIDTH - 1, y + 1, material);
-                                        chunkLeft->m_isFreeFalling[WIDTH * (y + 1) + WIDTH - 1] = true;
-                                        chunkLeft->setShouldUpdateNextFrame(true);
-                                    } else if (y == HEIGHT - 1 && chunkBelow) {
-                                        chunkBelow->set(x - 1, 0, material);
-                                        chunkBelow->m_isFreeFalling[x - 1] = true;
-                                        chunkBelow->setShouldUpdateNextFrame(true);
-                                    } else if (downLeftIdx < static_cast<int>(m_grid.size())) {
-                                        m_grid[downLeftIdx] = material;
-                                        m_isFreeFalling[downLeftIdx] = true;
-                                    }
-                                    
-                                    m_grid[idx] = MaterialType::Empty;
-                                    movedDiagonally = true;
-                                    anyMaterialMoved = true;
-                                }
-                            }
-                            
-                            // If couldn't move left, try right
-                            if (!movedDiagonally && x < WIDTH - 1) {
-                                int downRightIdx = (y + 1) * WIDTH + (x + 1);
-                                MaterialType downRightMaterial = MaterialType::Empty;
-                                
-                                // Handle cross-chunk boundaries if needed
-                                if (x == WIDTH - 1 && y == HEIGHT - 1 && chunkBelow && chunkRight) {
-                                    downRightMaterial = chunkBelow->get(0, 0);
-                                } else if (x == WIDTH - 1 && chunkRight) {
-                                    downRightMaterial = chunkRight->get(0, y + 1);
-                                } else if (y == HEIGHT - 1 && chunkBelow) {
-                                    downRightMaterial = chunkBelow->get(x + 1, 0);
-                                } else if (downRightIdx < static_cast<int>(m_grid.size())) {
-                                    downRightMaterial = m_grid[downRightIdx];
-                                }
-                                
-                                if (downRightMaterial == MaterialType::Empty) {
-                                    // Handle cross-chunk boundaries
-                                    if (x == WIDTH - 1 && y == HEIGHT - 1 && chunkBelow && chunkRight) {
-                                        chunkBelow->set(0, 0, material);
-                                        chunkBelow->m_isFreeFalling[0] = true;
-                                        chunkBelow->setShouldUpdateNextFrame(true);
-                                    } else if (x == WIDTH - 1 && chunkRight) {
-                                        chunkRight->set(0, y + 1, material);
-                                        chunkRight->m_isFreeFalling[WIDTH * (y + 1)] = true;
-                                        chunkRight->setShouldUpdateNextFrame(true);
-                                    } else if (y == HEIGHT - 1 && chunkBelow) {
-                                        chunkBelow->set(x + 1, 0, material);
-                                        chunkBelow->m_isFreeFalling[x + 1] = true;
-                                        chunkBelow->setShouldUpdateNextFrame(true);
-                                    } else if (downRightIdx < static_cast<int>(m_grid.size())) {
-                                        m_grid[downRightIdx] = material;
-                                        m_isFreeFalling[downRightIdx] = true;
-                                    }
-                                    
-                                    m_grid[idx] = MaterialType::Empty;
-                                    movedDiagonally = true;
-                                    anyMaterialMoved = true;
-                                }
-                            }
-                        } else {
-                            // Try right-first instead (same code but order is reversed)
-                            // Try down-right first
-                            if (x < WIDTH - 1) {
-                                int downRightIdx = (y + 1) * WIDTH + (x + 1);
-                                MaterialType downRightMaterial = MaterialType::Empty;
-                                
-                                // Handle cross-chunk boundaries
-                                if (x == WIDTH - 1 && y == HEIGHT - 1 && chunkBelow && chunkRight) {
-                                    downRightMaterial = chunkBelow->get(0, 0);
-                                } else if (x == WIDTH - 1 && chunkRight) {
-                                    downRightMaterial = chunkRight->get(0, y + 1);
-                                } else if (y == HEIGHT - 1 && chunkBelow) {
-                                    downRightMaterial = chunkBelow->get(x + 1, 0);
-                                } else if (downRightIdx < static_cast<int>(m_grid.size())) {
-                                    downRightMaterial = m_grid[downRightIdx];
-                                }
-                                
-                                if (downRightMaterial == MaterialType::Empty) {
-                                    // Handle cross-chunk boundaries
-                                    if (x == WIDTH - 1 && y == HEIGHT - 1 && chunkBelow && chunkRight) {
-                                        chunkBelow->set(0, 0, material);
-                                        chunkBelow->m_isFreeFalling[0] = true;
-                                        chunkBelow->setShouldUpdateNextFrame(true);
-                                    } else if (x == WIDTH - 1 && chunkRight) {
-                                        chunkRight->set(0, y + 1, material);
-                                        chunkRight->m_isFreeFalling[WIDTH * (y + 1)] = true;
-                                        chunkRight->setShouldUpdateNextFrame(true);
-                                    } else if (y == HEIGHT - 1 && chunkBelow) {
-                                        chunkBelow->set(x + 1, 0, material);
-                                        chunkBelow->m_isFreeFalling[x + 1] = true;
-                                        chunkBelow->setShouldUpdateNextFrame(true);
-                                    } else if (downRightIdx < static_cast<int>(m_grid.size())) {
-                                        m_grid[downRightIdx] = material;
-                                        m_isFreeFalling[downRightIdx] = true;
-                                    }
-                                    
-                                    m_grid[idx] = MaterialType::Empty;
-                                    movedDiagonally = true;
-                                    anyMaterialMoved = true;
-                                }
-                            }
-                            
-                            // If couldn't move right, try left
-                            if (!movedDiagonally && x > 0) {
-                                int downLeftIdx = (y + 1) * WIDTH + (x - 1);
-                                MaterialType downLeftMaterial = MaterialType::Empty;
-                                
-                                // Handle cross-chunk boundaries
-                                if (x == 0 && y == HEIGHT - 1 && chunkBelow && chunkLeft) {
-                                    downLeftMaterial = chunkBelow->get(WIDTH - 1, 0);
-                                } else if (x == 0 && chunkLeft) {
-                                    downLeftMaterial = chunkLeft->get(WIDTH - 1, y + 1);
-                                } else if (y == HEIGHT - 1 && chunkBelow) {
-                                    downLeftMaterial = chunkBelow->get(x - 1, 0);
-                                } else if (downLeftIdx < static_cast<int>(m_grid.size())) {
-                                    downLeftMaterial = m_grid[downLeftIdx];
-                                }
-                                
-                                if (downLeftMaterial == MaterialType::Empty) {
-                                    // Handle cross-chunk boundaries
-                                    if (x == 0 && y == HEIGHT - 1 && chunkBelow && chunkLeft) {
-                                        chunkBelow->set(WIDTH - 1, 0, material);
-                                        chunkBelow->m_isFreeFalling[WIDTH * 0 + WIDTH - 1] = true;
-                                        chunkBelow->setShouldUpdateNextFrame(true);
-                                    } else if (x == 0 && chunkLeft) {
-                                        chunkLeft->set(WIDTH - 1, y + 1, material);
-                                        chunkLeft->m_isFreeFalling[WIDTH * (y + 1) + WIDTH - 1] = true;
-                                        chunkLeft->setShouldUpdateNextFrame(true);
-                                    } else if (y == HEIGHT - 1 && chunkBelow) {
-                                        chunkBelow->set(x - 1, 0, material);
-                                        chunkBelow->m_isFreeFalling[x - 1] = true;
-                                        chunkBelow->setShouldUpdateNextFrame(true);
-                                    } else if (downLeftIdx < static_cast<int>(m_grid.size())) {
-                                        m_grid[downLeftIdx] = material;
-                                        m_isFreeFalling[downLeftIdx] = true;
-                                    }
-                                    
-                                    m_grid[idx] = MaterialType::Empty;
-                                    movedDiagonally = true;
-                                    anyMaterialMoved = true;
-                                }
-                            }
-                        }
-                        
-                        // If this material moved, continue to the next cell
-                        if (movedDiagonally) {
-                            continue;
-                        }
-                    }
-                }
-                
-                // If we reached here, the material didn't move this frame
-                // So we update its falling status
-                if (anyMaterialMoved) {
-                    // Material didn't move, but others have, so consider whether to set it to free falling 
-                    // This simulates neighboring particles knocking it loose
-                    // The higher the inertial resistance, the less likely it is to be set to freefalling
-                    uint8_t resistance = props.inertialResistance; // 0-100 scale
-                    if (m_rng() % 100 < (100 - resistance)) {
-                        // Set to free falling with a probability inversely proportional to inertial resistance
-                        m_isFreeFalling[idx] = true;
-                    } else {
-                        // Material stays settled
-                        m_isFreeFalling[idx] = false;
+                        markCellDirty(x, y);
+                        markCellDirty(nx, topY);
                     }
-                } else {
-                    // Nothing moved, material stays where it is
-                    m_isFreeFalling[idx] = false;
+                    break;
                 }
             }
-        }
-    }
-    
-    // Now handle liquids - process bottom-to-top for falling, then left-to-right for spreading
-    // First pass: vertical movement (falling)
-    for (int y = HEIGHT - 1; y >= 0; --y) {
-        for (int x = 0; x < WIDTH; ++x) {
-            int idx = y * WIDTH + x;
-            MaterialType material = oldGrid[idx];
-            
-            // Skip empty cells or cells that have moved
-            if (material == MaterialType::Empty || oldGrid[idx] != m_grid[idx]) {
-                continue;
-            }
-            
-            const auto& props = MAT_PROPS(material);
-            
-            // Handle liquid falling
-            if (props.isLiquid) {
-                if (y < HEIGHT - 1) {
-                    // Check directly below
-                    int belowIdx = (y + 1) * WIDTH + x;
-                    MaterialType belowMaterial = (belowIdx < static_cast<int>(m_grid.size())) ? 
-                                                m_grid[belowIdx] : MaterialType::Empty;
-                    
-                    // Handle cross-chunk boundary for liquids
-                    if (y == HEIGHT - 1 && chunkBelow) {
-                        belowMaterial = chunkBelow->get(x, 0);
-                        
-                        // Check if liquid can fall through chunk boundary
-                        if (canDisplace(material, belowMaterial)) {
-                            chunkBelow->set(x, 0, material);
-                            m_grid[idx] = MaterialType::Empty; // Always remove source for volume conservation
-                            anyMaterialMoved = true;
-                            chunkBelow->setShouldUpdateNextFrame(true);
-                            continue;
-                        }
-                        
-                        // Special case for handling liquids at chunk boundary
-                        // Try diagonal movement if direct downward movement isn't possible
-                        if (belowMaterial != MaterialType::Empty) {
-                            bool moved = false;
-                            
-                            // Randomly choose which side to try first for more natural-looking flow
-                            bool tryLeftFirst = (m_rng() % 2 == 0);
-                            
-                            if (tryLeftFirst) {
-                                // Try down-left first
-                                if (x > 0) {
-                                    MaterialType downLeftMaterial = chunkBelow->get(x - 1, 0);
-                                    if (downLeftMaterial == MaterialType::Empty) {
-                                        chunkBelow->set(x - 1, 0, material);
-                                        m_grid[idx] = MaterialType::Empty;
-                                        anyMaterialMoved = true;
-                                        chunkBelow->setShouldUpdateNextFrame(true);
-                                        moved = true;
-                                    }
-                                }
-                                
-                                // Then try down-right
-                                if (!moved && x < WIDTH - 1) {
-                                    MaterialType downRightMaterial = chunkBelow->get(x + 1, 0);
-                                    if (downRightMaterial == MaterialType::Empty) {
-                                        chunkBelow->set(x + 1, 0, material);
-                                        m_grid[idx] = MaterialType::Empty;
-                                        anyMaterialMoved = true;
-                                        chunkBelow->setShouldUpdateNextFrame(true);
-                                        moved = true;
-                                    }
-                                }
-                            } else {
-                                // Try down-right first
-                                if (x < WIDTH - 1) {
-                                    MaterialType downRightMaterial = chunkBelow->get(x + 1, 0);
-                                    if (downRightMaterial == MaterialType::Empty) {
-                                        chunkBelow->set(x + 1, 0, material);
-                                        m_grid[idx] = MaterialType::Empty;
-                                        anyMaterialMoved = true;
-                                        chunkBelow->setShouldUpdateNextFrame(true);
-                                        moved = true;
-                                    }
-                                }
-                                
-                                // Then try down-left
-                                if (!moved && x > 0) {
-                                    MaterialType downLeftMaterial = chunkBelow->get(x - 1, 0);
-                                    if (downLeftMaterial == MaterialType::Empty) {
-                                        chunkBelow->set(x - 1, 0, material);
-                                        m_grid[idx] = MaterialType::Empty;
-                                        anyMaterialMoved = true;
-                                        chunkBelow->setShouldUpdateNextFrame(true);
-                                        moved = true;
-                                    }
-                                }
-                            }
-                            
-                            if (moved) {
-                                continue;
-                            }
-                            
-                            // Always mark the chunk below for next frame update
-                            chunkBelow->setShouldUpdateNextFrame(true);
-                        }
-                    } else if (belowIdx < static_cast<int>(m_grid.size())) {
-                        // Within same chunk - check if liquid can displace what's below
-                        if (canDisplace(material, belowMaterial)) {
-                            // Move liquid down, potentially displacing another liquid
-                            m_grid[belowIdx] = material;
-                            m_grid[idx] = MaterialType::Empty; // For volume conservation
-                            anyMaterialMoved = true;
-                            continue;
-                        }
-                        
-                        // If can't move down, try diagonal
-                        if (belowMaterial != MaterialType::Empty) {
-                            bool moved = false;
-                            
-                            // Randomly choose which side to try first
-                            bool tryLeftFirst = (m_rng() % 2 == 0);
-                            
-                            if (tryLeftFirst) {
-                                // Try down-left
-                                if (x > 0) {
-                                    int downLeftIdx = (y + 1) * WIDTH + (x - 1);
-                                    if (downLeftIdx < static_cast<int>(m_grid.size())) {
-                                        MaterialType downLeftMaterial = m_grid[downLeftIdx];
-                                        if (downLeftMaterial == MaterialType::Empty) {
-                                            m_grid[downLeftIdx] = material;
-                                            m_grid[idx] = MaterialType::Empty;
-                                            anyMaterialMoved = true;
-                                            moved = true;
-                                        }
-                                    }
-                                }
-                                
-                                // Try down-right if didn't move left
-                                if (!moved && x < WIDTH - 1) {
-                                    int downRightIdx = (y + 1) * WIDTH + (x + 1);
-                                    if (downRightIdx < static_cast<int>(m_grid.size())) {
-                                        MaterialType downRightMaterial = m_grid[downRightIdx];
-                                        if (downRightMaterial == MaterialType::Empty) {
-                                            m_grid[downRightIdx] = material;
-                                            m_grid[idx] = MaterialType::Empty;
-                                            anyMaterialMoved = true;
-                                            moved = true;
-                                        }
-                                    }
-                                }
-                            } else {
-                                // Try down-right first
-                                if (x < WIDTH - 1) {
-                                    int downRightIdx = (y + 1) * WIDTH + (x + 1);
-                                    if (downRightIdx < static_cast<int>(m_grid.size())) {
-                                        MaterialType downRightMaterial = m_grid[downRightIdx];
-                                        if (downRightMaterial == MaterialType::Empty) {
-                                            m_grid[downRightIdx] = material;
-                                            m_grid[idx] = MaterialType::Empty;
-                                            anyMaterialMoved = true;
-                                            moved = true;
-                                        }
-                                    }
-                                }
-                                
-                                // Try down-left if didn't move right
-                                if (!moved && x > 0) {
-                                    int downLeftIdx = (y + 1) * WIDTH + (x - 1);
-                                    if (downLeftIdx < static_cast<int>(m_grid.size())) {
-                                        MaterialType downLeftMaterial = m_grid[downLeftIdx];
-                                        if (downLeftMaterial == MaterialType::Empty) {
-                                            m_grid[downLeftIdx] = material;
-                                            m_grid[idx] = MaterialType::Empty;
-                                            anyMaterialMoved = true;
-                                            moved = true;
-                                        }
-                                    }
-                                }
-                            }
-                            
-                            if (moved) {
-                                continue;
-                            }
-                        }
-                    }
-                }
-            }
-        }
-    }
-    
-    // Second pass: horizontal spreading for liquids with improved mechanics
-    std::vector<MaterialType> spreadGrid = m_grid; // Copy current state for consistent spreading
-    
-    // Process liquids from bottom to top
-    for (int y = HEIGHT - 1; y >= 0; --y) {
-        // Use alternating directions for balanced spreading
-        for (int iteration = 0; iteration < 2; ++iteration) {
-            bool leftToRight = (iteration == 0);
-            
-            for (int i = 0; i < WIDTH; ++i) {
-                int x = leftToRight ? i : (WIDTH - 1 - i);
-                int idx = y * WIDTH + x;
+            // If found empty space
+            else if (sideNeighbor == MaterialType::Empty) {
+                // Check for cell below this empty space for support
+                bool hasSupport = (m_cells[sideIdx + STRIDE].material != MaterialType::Empty);
+            
+                // Check each cell along the path to ensure we don't skip over solid blocks
+                bool pathBlocked = false;
+                for (int checkSpread = 1; checkSpread < spread; checkSpread++) {
+                    int checkX = x + (spreadDirection * checkSpread);
+                    MaterialType checkMaterial = m_cells[cellIndex(checkX, y)].material;
                 
-                // Skip cells that aren't liquids or were already processed
-                MaterialType material = spreadGrid[idx];
-                if (material == MaterialType::Empty || !(m_grid[idx] == material)) {
-                    continue;
-                }
-                
-                const auto& props = MAT_PROPS(material);
-                if (!props.isLiquid) {
-                    continue;
-                }
-                
-                // Check if there's a fluid cell directly below
-                bool hasLiquidBelow = false;
-                bool hasEmptyBelow = false;
-                MaterialType belowMaterial = MaterialType::Empty;
-                
-                if (y < HEIGHT - 1) {
-                    int belowIdx = (y + 1) * WIDTH + x;
-                    belowMaterial = (belowIdx < static_cast<int>(m_grid.size())) ? 
-                                         m_grid[belowIdx] : MaterialType::Empty;
-                    
-                    if (y == HEIGHT - 1 && chunkBelow) {
-                        belowMaterial = chunkBelow->get(x, 0);
-                    }
-                    
-                    const auto& belowProps = MAT_PROPS(belowMaterial);
-                    hasLiquidBelow = (belowMaterial == material); // Same liquid type below
-                    hasEmptyBelow = (belowMaterial == MaterialType::Empty);
-                }
-                
-                // ONLY spread horizontally if:
-                // 1. We can't fall downward (blocked by something that's not empty)
-                // 2. OR we have same liquid below us (part of a water column)
-                if (!hasEmptyBelow || hasLiquidBelow) {
-                    // Look for water level discrepancies
-                    int liquidColumnHeight = 0;
-                    
-                    // Calculate height of fluid column at current position
-                    for (int checkY = y; checkY >= 0; --checkY) {
-                        int checkIdx = checkY * WIDTH + x;
-                        if (checkIdx >= 0 && checkIdx < static_cast<int>(m_grid.size())) {
-                            if (m_grid[checkIdx] == material) {
-                                liquidColumnHeight++;
-                            } else {
-                                break; // Stop at first non-matching material
-                            }
-                        }
-                    }
-                    
-                    // Set spread direction based on iteration
-                    int spreadDirection = leftToRight ? 1 : -1;
-                    
-                    // Get material-specific dispersal rate from properties
-                    int dispersalRate = props.dispersalRate;
-                    
-                    // Higher liquid columns create more pressure (further spreading)
-                    int liquidPressure = std::min(dispersalRate + (liquidColumnHeight / 2), 8);
-                    
-                    // Search for empty spaces or lower liquid columns to flow to
-                    for (int spread = 1; spread <= liquidPressure; ++spread) {
-                        int nx = x + (spreadDirection * spread);
-                        MaterialType sideNeighbor = MaterialType::Empty;
-                        int sideIdx = -1;
-                        bool isCrossingChunk = false;
-                        Chunk* targetChunk = nullptr;
-                        int targetX = -1;
-                        
-                        // Handle cross-chunk boundaries for horizontal spread
-                        if (nx < 0 && chunkLeft) {
-                            // Crossing left chunk boundary
-                            int leftChunkX = WIDTH + nx; // Convert to other chunk coordinates
-                            sideNeighbor = chunkLeft->get(leftChunkX, y);
-                            isCrossingChunk = true;
-                            targetChunk = chunkLeft;
-                            targetX = leftChunkX;
-                        } else if (nx >= WIDTH && chunkRight) {
-                            // Crossing right chunk boundary
-                            int rightChunkX = nx - WIDTH; // Convert to other chunk coordinates
-                            sideNeighbor = chunkRight->get(rightChunkX, y);
-                            isCrossingChunk = true;
-                            targetChunk = chunkRight;
-                            targetX = rightChunkX;
-                        } else if (nx >= 0 && nx < WIDTH) {
-                            // Within same chunk
-                            sideIdx = y * WIDTH + nx;
-                            if (sideIdx < static_cast<int>(m_grid.size())) {
-                                sideNeighbor = m_grid[sideIdx];
-                            }
-                        } else {
-                            break; // Out of bounds with no chunk
-                        }
-                        
-                        // If we hit same liquid, check column height
-                        if (sideNeighbor == material) {
-                            // Calculate height of side column
-                            int sideColumnHeight = 0;
-                            
-                            if (isCrossingChunk) {
-                                // Count liquid cells in the neighboring chunk column
-                                for (int checkY = y; checkY >= 0; --checkY) {
-                                    MaterialType checkMaterial = targetChunk->get(targetX, checkY);
-                                    if (checkMaterial == material) {
-                                        sideColumnHeight++;
-                                    } else {
-                                        break;
-                                    }
-                                }
-                            } else {
-                                // Count liquid cells in current chunk
-                                for (int checkY = y; checkY >= 0; --checkY) {
-                                    int checkIdx = checkY * WIDTH + nx;
-                                    if (checkIdx >= 0 && checkIdx < static_cast<int>(m_grid.size())) {
-                                        if (m_grid[checkIdx] == material) {
-                                            sideColumnHeight++;
-                                        } else {
-                                            break;
-                                        }
-                                    }
-                                }
-                            }
-                            
-                            // If this column is higher, continue searching outward
-                            if (liquidColumnHeight <= sideColumnHeight) {
-                                continue;
-                            }
-                            
-                            // If current column is significantly higher, try to level it out
-                            if (liquidColumnHeight > sideColumnHeight + 1) {
-                                // Found a lower column - try to equalize heights
-                                if (isCrossingChunk) {
-                                    // Move material to neighbor chunk column
-                                    targetChunk->set(targetX, y - sideColumnHeight, material);
-                                    m_grid[idx] = MaterialType::Empty;
-                                    targetChunk->setShouldUpdateNextFrame(true);
-                                    anyMaterialMoved = true;
-                                } else {
-                                    // Move material to lower column within same chunk
-                                    m_grid[y * WIDTH + nx] = material;
-                                    m_grid[idx] = MaterialType::Empty;
-                                    anyMaterialMoved = true;
-                                }
-                                break;
-                            }
-                        }
-                        // If found empty space
-                        else if (sideNeighbor == MaterialType::Empty) {
-                            // Check for cell below this empty space for support
-                            bool hasSupport = false;
-                            
-                            if (isCrossingChunk) {
-                                if (y < HEIGHT - 1) {
-                                    MaterialType belowNeighbor = targetChunk->get(targetX, y + 1);
-                                    hasSupport = (belowNeighbor != MaterialType::Empty);
-                                }
-                            } else {
-                                if (y < HEIGHT - 1 && nx >= 0 && nx < WIDTH) {
-                                    int belowNeighborIdx = (y + 1) * WIDTH + nx;
-                                    if (belowNeighborIdx < static_cast<int>(m_grid.size())) {
-                                        MaterialType belowNeighbor = m_grid[belowNeighborIdx];
-                                        hasSupport = (belowNeighbor != MaterialType::Empty);
-                                    }
-                                }
-                            }
-                            
-                            // Check each cell along the path to ensure we don't skip over solid blocks
-                            bool pathBlocked = false;
-                            for (int checkSpread = 1; checkSpread < spread; checkSpread++) {
-                                int checkX = x + (spreadDirection * checkSpread);
-                                // Handle cross-chunk checks
-                                MaterialType checkMaterial = MaterialType::Empty;
-                                
-                                if (checkX < 0 && chunkLeft) {
-                                    int leftCheckX = WIDTH + checkX;
-                                    checkMaterial = chunkLeft->get(leftCheckX, y);
-                                } else if (checkX >= WIDTH && chunkRight) {
-                                    int rightCheckX = checkX - WIDTH;
-                                    checkMaterial = chunkRight->get(rightCheckX, y);
-                                } else if (checkX >= 0 && checkX < WIDTH) {
-                                    checkMaterial = m_grid[y * WIDTH + checkX];
-                                }
-                                
-                                // If a solid block is in the way, path is blocked
-                                if (checkMaterial != MaterialType::Empty && checkMaterial != material) {
-                                    const auto& checkProps = MATERIAL_PROPERTIES[static_cast<std::size_t>(checkMaterial)];
-                                    if (checkProps.isSolid) {
-                                        pathBlocked = true;
-                                        break;
-                                    }
-                                }
-                            }
-                            
-                            // Only flow horizontally if the path is clear and the destination has support
-                            // or if it's very close to the source
-                            if (!pathBlocked && (hasSupport || spread <= 1)) {
-                                if (isCrossingChunk) {
-                                    // Move material to neighboring chunk
-                                    targetChunk->set(targetX, y, material);
-                                    m_grid[idx] = MaterialType::Empty;
-                                    targetChunk->setShouldUpdateNextFrame(true);
-                                    anyMaterialMoved = true;
-                                } else {
-                                    // Move material within same chunk
-                                    m_grid[sideIdx] = material;
-                                    m_grid[idx] = MaterialType::Empty;
-                                    anyMaterialMoved = true;
-                                }
-                                break;
-                            }
-                        } 
-                        // If hit different material type, stop searching
-                        else if (sideNeighbor != material) {
+                    // If a solid block is in the way, path is blocked
+                    if (checkMaterial != MaterialType::Empty && checkMaterial != material) {
+                        if (materials.is(checkMaterial, MATERIAL_SOLID)) {
+                            pathBlocked = true;
                             break;
                         }
                     }
                 }
+            
+                // Only flow horizontally if the path is clear and the destination has support
+                // or if it's very close to the source
+                if (!pathBlocked && (hasSupport || spread <= 1)) {
+                    // A lone surface cell sliding onto support changes no level: it is drift,
+                    // which does not keep the tiles from falling asleep
+                    const bool drift = hasSupport && liquidColumnHeight == 1;
+                    moveCell(idx, sideIdx, m_spreadStamp);
+                    anyMaterialMoved = true;
+                    markCellDirty(x, y, drift);
+                    markCellDirty(nx, y, drift);
+                    break;
+                }
+            } 
+            // If hit different material type, stop searching
+            else if (sideNeighbor != material) {
+                break;
             }
         }
     }
-    
+}
 
-    
-    // Handle gas rise (for fire, flammable gas, etc.)
-    for (int y = 0; y < HEIGHT; ++y) {  // Bottom-up for gases (they rise)
-        for (int x = 0; x < WIDTH; ++x) {
-            int idx = y * WIDTH + x;
-            MaterialType material = oldGrid[idx];
-            
-            if (material != MaterialType::Empty && material != m_grid[idx]) {
-                continue; // Skip if already moved
-            }
-            
-            const auto& props = MATERIAL_PROPERTIES[static_cast<std::size_t>(material)];
-            
-            if (props.isGas) {
-                // Try to rise upward
-                if (y > 0) {
-                    int aboveIdx = (y - 1) * WIDTH + x;
-                    
-                    if (aboveIdx >= 0 && aboveIdx < static_cast<int>(m_grid.size())) {
-                        MaterialType aboveMaterial = m_grid[aboveIdx];
-                        
-                        // Gases can rise through empty space
-                        if (aboveMaterial == MaterialType::Empty) {
-                            m_grid[aboveIdx] = material;
-                            m_grid[idx] = MaterialType::Empty;
-                            anyMaterialMoved = true;
-                        }
-                        // Gases can rise through liquids (creating bubbles)
-                        else {
-                            const auto& aboveProps = MATERIAL_PROPERTIES[static_cast<std::size_t>(aboveMaterial)];
-                            if (aboveProps.isLiquid) {
-                                // Swap positions - gas rises through liquid
-                                m_grid[aboveIdx] = material;
-                                m_grid[idx] = aboveMaterial;
-                                anyMaterialMoved = true;
-                            }
-                        }
-                    }
-                }
-            }
+bool Chunk::stepGas(int x, int y, bool& anyMaterialMoved) {
+    int idx = cellIndex(x, y);
+    
+    // Try to rise upward (row -1 is the halo, so the top row rises into the chunk above)
+    int aboveIdx = idx - STRIDE;
+    MaterialType aboveMaterial = m_cells[aboveIdx].material;
+    
+    // Gases can rise through empty space
+    if (aboveMaterial == MaterialType::Empty) {
+        moveCell(idx, aboveIdx, m_fallStamp);
+        anyMaterialMoved = true;
+        markCellDirty(x, y);
+        return true;
+    }
+    // Gases rise through anything heavier resting on them (creating bubbles)
+    if (g_displacement.canDisplace(aboveMaterial, m_cells[idx].material)) {
+        swapCells(aboveIdx, idx, m_fallStamp);
+        anyMaterialMoved = true;
+        markCellDirty(x, y);
+        return true;
+    }
+    return false;
+}
+
+void Chunk::stepPowder(int x, int y, bool& anyMaterialMoved) {
+    int idx = cellIndex(x, y);
+    MaterialType material = m_cells[idx].material;
+    
+    // Keep track of whether this material is currently moving
+    m_cells[idx].freeFalling = true;
+    
+    // Check directly below. The halo row and columns make the three cells below valid
+    // for every cell of the chunk; moves into them reach the neighbours at the halo flush.
+    int belowIdx = idx + STRIDE;
+    if (m_cells[belowIdx].material == MaterialType::Empty) {
+        // Pick up speed and fall straight down through as many empty cells
+        const int speed = std::min(m_cells[idx].velocity + 1, Physics::MAX_FALL_SPEED);
+        const int distance = fallDistance(idx, y, speed);
+        moveCell(idx, idx + distance * STRIDE, m_fallStamp);
+        anyMaterialMoved = true;
+        markCellDirty(x, y);
+        markCellDirty(x, y + distance);
+        
+        // Mark the particle as free-falling
+        Cell& fallen = m_cells[idx + distance * STRIDE];
+        fallen.freeFalling = true;
+        fallen.velocity = static_cast<int8_t>(speed);
+        return; // Done moving this particle
+    }
+    
+    // Handle diagonal movement - randomly choose which side to check first for more
+    // natural behavior
+    bool checkLeftFirst = (random(x, y, SALT_POWDER_SIDE) % 2 == 0);
+    int firstIdx = belowIdx + (checkLeftFirst ? -1 : 1);
+    int secondIdx = belowIdx + (checkLeftFirst ? 1 : -1);
+    
+    for (int targetIdx : {firstIdx, secondIdx}) {
+        if (m_cells[targetIdx].material == MaterialType::Empty) {
+            moveCell(idx, targetIdx, m_fallStamp);
+            m_cells[targetIdx].freeFalling = true;
+            anyMaterialMoved = true;
+            markCellDirty(x, y);
+            return;
         }
     }
     
-    // Handle material interactions (like fire spreading, water effects, etc.)
-    handleMaterialInteractions(oldGrid, anyMaterialMoved);
+    // Nowhere to fall: sink through a lighter liquid or gas below, one cell per update
+    if (g_displacement.canDisplace(material, m_cells[belowIdx].material)) {
+        swapCells(idx, belowIdx, m_fallStamp);
+        m_cells[belowIdx].freeFalling = true;
+        m_cells[belowIdx].velocity = 0;
+        anyMaterialMoved = true;
+        markCellDirty(x, y);
+        return;
+    }
     
-    // Mark the chunk for update next frame if materials moved
-    // This allows materials to continue being simulated even without player interaction
+    // If we reached here, the material didn't move this frame
+    // So it loses its speed and we update its falling status
+    m_cells[idx].velocity = 0;
     if (anyMaterialMoved) {
-        setShouldUpdateNextFrame(true);
-        
-        // Mark neighboring chunks as potentially needing updates too
-        if (chunkBelow) chunkBelow->setShouldUpdateNextFrame(true);
-        if (chunkLeft) chunkLeft->setShouldUpdateNextFrame(true);
-        if (chunkRight) chunkRight->setShouldUpdateNextFrame(true);
+        // Material didn't move, but others have, so consider whether to set it to free falling 
+        // This simulates neighboring particles knocking it loose
+        // The higher the inertial resistance, the less likely it is to be set to freefalling
+        uint8_t resistance = MaterialRegistry::tables().inertia[static_cast<std::size_t>(material)]; // 0-100 scale
+        if (random(x, y, SALT_POWDER_KNOCK) % 100 < static_cast<uint64_t>(100 - resistance)) {
+            // Set to free falling with a probability inversely proportional to inertial resistance
+            m_cells[idx].freeFalling = true;
+        } else {
+            // Material stays settled
+            m_cells[idx].freeFalling = false;
+        }
+    } else {
+        // Nothing moved, material stays where it is
+        m_cells[idx].freeFalling = false;
     }
-    
-    // Update the pixel data to reflect the changes
-    updatePixelData();
 }
 
-bool Chunk::canDisplace(MaterialType above, MaterialType below) const {
-    // If below is empty, anything can fall into it
-    if (below == MaterialType::Empty) {
-        return true;
-    }
-    
-    // Get properties of both materials
-    const auto& aboveProps = MATERIAL_PROPERTIES[static_cast<std::size_t>(above)];
-    const auto& belowProps = MATERIAL_PROPERTIES[static_cast<std::size_t>(below)];
+namespace {
+
+// Row bitboards hold one bit per cell of a chunk row: bit i of word k is cell k * 64 + i
+constexpr int ROW_WORDS = Chunk::WIDTH / 64;
+static_assert(Chunk::WIDTH % 64 == 0, "Powder bitboards need whole 64-cell words per row");
+static_assert(Chunk::TILE_SIZE == 64, "Powder bitboards treat one word as one tile");
+using RowBits = uint64_t[ROW_WORDS];
+
+// Word k of a row bitboard moved one cell toward higher x (the bit for x lands on x + 1).
+// haloBit is shifted in for the halo cell x = -1.
+inline uint64_t towardHigherX(const RowBits bits, int k, uint64_t haloBit = 0) {
+    return (bits[k] << 1) | (k > 0 ? bits[k - 1] >> 63 : haloBit);
+}
+
+// Word k of a row bitboard moved one cell toward lower x (the bit for x lands on x - 1).
+// haloBit is shifted in for the halo cell x = WIDTH.
+inline uint64_t towardLowerX(const RowBits bits, int k, uint64_t haloBit = 0) {
+    return (bits[k] >> 1) | (k + 1 < ROW_WORDS ? bits[k + 1] << 63 : haloBit << 63);
+}
+
+// Masks of one 64-cell word of a row, bit i for cell i
+struct WordCells {
+    uint64_t powder;
+    uint64_t empty;
+    uint64_t fluid;
+    uint64_t moving;    // Cells with a speed or the freeFalling mark
+};
+
+// Bits of a cell's 4 bytes that are set while it is in motion: its velocity and freeFalling
+const uint32_t CELL_MOTION_BITS = [] {
+    Cell cell;                  // Empty: every other field is zero
+    cell.freeFalling = 1;
+    cell.velocity = -1;
+    uint32_t bits;
+    std::memcpy(&bits, &cell, sizeof(bits));
+    return bits;
+}();
+
+inline WordCells classifyWordScalar(const Cell* cells) {
+    WordCells word = {};
+    for (int i = 0; i < 64; ++i) {
+        const uint64_t flags = g_powderFlags.flags[static_cast<std::size_t>(cells[i].material)];
+        uint32_t bits;
+        std::memcpy(&bits, &cells[i], sizeof(bits));
+        word.powder |= (flags & POWDER_FLAG) << i;
+        word.empty |= ((flags & EMPTY_FLAG) >> 1) << i;
+        word.fluid |= ((flags & FLUID_FLAG) >> 2) << i;
+        word.moving |= uint64_t((bits & CELL_MOTION_BITS) != 0) << i;
+    }
+    return word;
+}
+
+#ifdef PIXELPHYS_AVX2_POWDER_MASKS
+// 8 cells per step: one gather fetches the flags of the 8 materials (the low byte of each cell)
+// and each flag is shifted into the sign bit for a movemask
+__attribute__((target("avx2")))
+WordCells classifyWordAVX2(const Cell* cells) {
+    static_assert(sizeof(Cell) == 4 && offsetof(Cell, material) == 0, "the gather reads the material byte");
+    static_assert(POWDER_FLAG == 1 && EMPTY_FLAG == 2 && FLUID_FLAG == 4, "flags are moved to bit 31 by shifts");
+    const __m256i materialMask = _mm256_set1_epi32(0xFF);
+    const __m256i motionBits = _mm256_set1_epi32(static_cast<int>(CELL_MOTION_BITS));
+    const int* flagTable = reinterpret_cast<const int*>(g_powderFlags.flags);
+    uint64_t powder = 0;
+    uint64_t empty = 0;
+    uint64_t fluid = 0;
+    uint64_t still = 0;
+    for (int i = 0; i < 64; i += 8) {
+        const __m256i words = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(cells + i));
+        const __m256i flags = _mm256_i32gather_epi32(flagTable, _mm256_and_si256(words, materialMask), 4);
+        powder |= uint64_t(_mm256_movemask_ps(_mm256_castsi256_ps(_mm256_slli_epi32(flags, 31)))) << i;
+        empty |= uint64_t(_mm256_movemask_ps(_mm256_castsi256_ps(_mm256_slli_epi32(flags, 30)))) << i;
+        fluid |= uint64_t(_mm256_movemask_ps(_mm256_castsi256_ps(_mm256_slli_epi32(flags, 29)))) << i;
+        const __m256i rest = _mm256_cmpeq_epi32(_mm256_and_si256(words, motionBits), _mm256_setzero_si256());
+        still |= uint64_t(_mm256_movemask_ps(_mm256_castsi256_ps(rest))) << i;
+    }
+    return {powder, empty, fluid, ~still};
+}
+#endif
+
+// Masks of the 64 cells starting at 'cells'
+inline WordCells classifyWord(const Cell* cells, bool useAVX2) {
+#ifdef PIXELPHYS_AVX2_POWDER_MASKS
+    if (useAVX2) {
+        return classifyWordAVX2(cells);
+    }
+#endif
+    (void)useAVX2;
+    return classifyWordScalar(cells);
+}
+
+bool cpuHasAVX2() {
+#ifdef PIXELPHYS_AVX2_POWDER_MASKS
+    static const bool hasAVX2 = __builtin_cpu_supports("avx2");
+    return hasAVX2;
+#else
+    return false;
+#endif
+}
+
+// Bits of word k that fall inside the column range [minX, maxX]
+inline uint64_t columnMask(int k, int minX, int maxX) {
+    int lo = std::max(0, minX - k * 64);
+    int hi = std::min(63, maxX - k * 64);
+    if (lo > hi) return 0;
+    uint64_t upToHi = (hi == 63) ? ~uint64_t(0) : ((uint64_t(1) << (hi + 1)) - 1);
+    return upToHi & ~((uint64_t(1) << lo) - 1);
+}
+
+// How far behind the fused sweep gases and reactions run. A falling cell lands up to
+// MAX_FALL_SPEED rows below its own, so rows further below the sweep have stopped moving;
+// reactions read and write up to two rows around a cell.
+constexpr int FUSED_GAS_LAG = Physics::MAX_FALL_SPEED + 1;
+constexpr int FUSED_REACTION_LAG = FUSED_GAS_LAG + 2;
+
+} // namespace
+
+void Chunk::updatePowdersBitboard(bool& anyMaterialMoved) {
+    // The rules of stepPowder (the scalar sweepCells<PowderPolicy> pass), 64 cells at a time:
+    // a grain falls into an empty cell below, otherwise into an empty cell down-left or
+    // down-right (random side first), otherwise sinks through a lighter liquid or gas below.
+    // Rows are still handled bottom-up, so each row sees the row below after its own moves.
+    RowCells below = {};                // Cells of the row below
+    bool haveBelow = false;             // 'below' was carried over from the previous (lower) row
     
-    // Powders can displace liquids if they're dense enough
-    if (aboveProps.isPowder && belowProps.isLiquid) {
-        // Dense powders like sand/gravel sink in all liquids
-        return true; // Sand/Gravel can fall through water/oil/etc.
+    for (int y = m_dirtyRect.maxY; y >= m_dirtyRect.minY; --y) {
+        haveBelow = updatePowderRowBitboard(y, below, haveBelow, anyMaterialMoved);
     }
+}
+
+bool Chunk::updatePowderRowBitboard(int y, RowCells& below, bool haveBelow, bool& anyMaterialMoved) {
+    const int minX = m_dirtyRect.minX;
+    const int maxX = m_dirtyRect.maxX;
     
-    // Liquids can't displace solids
-    if (aboveProps.isLiquid && belowProps.isSolid) {
+    // Words holding the scanned columns plus the one-cell diagonal reach on either side
+    const int wordLo = std::max(0, minX - 1) / 64;
+    const int wordHi = std::min(WIDTH - 1, maxX + 1) / 64;
+    
+    const uint32_t rowTiles = tileRowMask(m_awakeTiles, y);
+    if (rowTiles == 0) {
         return false;
     }
     
-    // Liquids can flow through each other based on density
-    if (aboveProps.isLiquid && belowProps.isLiquid) {
-        // Density-based displacement between liquids
-        if (above == MaterialType::Lava && below == MaterialType::Water) {
-            // Lava is denser than water, so it sinks
-            return true;
-        }
-        else if (above == MaterialType::Water && below == MaterialType::Oil) {
-            // Water is denser than oil, so it sinks below oil
-            return true;
+    // Cells of row y + 1 (the halo row for the last one), unless the caller carried them
+    // over from the row below
+    const bool useAVX2 = cpuHasAVX2();
+    if (!haveBelow) {
+        for (int k = wordLo; k <= wordHi; ++k) {
+            const WordCells word = classifyWord(&m_cells[cellIndex(k * 64, y + 1)], useAVX2);
+            below.empty[k] = word.empty;
+            below.fluid[k] = word.fluid;
         }
-        else if (above == MaterialType::Lava && below == MaterialType::Oil) {
-            // Lava is denser than oil, so it sinks
-            return true;
-        }
-        // Same liquid types don't displace each other
-        else if (above == below) {
-            return false;
-        }
-    }
-    
-    // Gases can rise through liquids
-    if (aboveProps.isGas && belowProps.isLiquid) {
-        return false; // Gases don't displace liquids downward
-    }
-    if (aboveProps.isLiquid && belowProps.isGas) {
-        return true; // Liquids fall through gases
     }
     
-    // Default: no displacement
-    return false;
-}
-
-void Chunk::handleMaterialInteractions(const std::vector<MaterialType>& oldGrid, bool& anyMaterialMoved) {
-    // Process all cells in the grid for material interactions
-    for (int y = 0; y < HEIGHT; ++y) {
-        for (int x = 0; x < WIDTH; ++x) {
-            int idx = y * WIDTH + x;
-            MaterialType current = m_grid[idx];
-            
-            // Skip empty cells
-            if (current == MaterialType::Empty) {
-                continue;
+    // The halo cells diagonally below the first and last cell of the row. Only the grain
+    // next to each can reach them, so they are never contested.
+    const uint64_t haloBelowLeft = m_cells[cellIndex(-1, y + 1)].material == MaterialType::Empty;
+    const uint64_t haloBelowRight = m_cells[cellIndex(WIDTH, y + 1)].material == MaterialType::Empty;
+    
+    // Bitboards of row y: grains this pass handles, empty and fluid cells, grains still in motion
+    RowBits grains = {};
+    RowBits empty = {};
+    RowBits fluid = {};
+    RowBits moving = {};
+    for (int k = wordLo; k <= wordHi; ++k) {
+        const WordCells word = classifyWord(&m_cells[cellIndex(k * 64, y)], useAVX2);
+        empty[k] = word.empty;
+        fluid[k] = word.fluid;
+        moving[k] = word.moving;
+        // Only grains inside the dirty rect and an awake tile move, like the scalar sweep
+        uint64_t scope = ((rowTiles >> k) & 1u) ? columnMask(k, minX, maxX) : 0;
+        grains[k] = word.powder & scope;
+    }
+    
+    // Straight down first
+    RowBits fall = {};
+    RowBits rest = {};
+    bool anyRest = false;
+    for (int k = wordLo; k <= wordHi; ++k) {
+        fall[k] = grains[k] & below.empty[k];
+        below.empty[k] &= ~fall[k];
+        rest[k] = grains[k] & ~fall[k];
+        anyRest |= rest[k] != 0;
+    }
+    
+    // Blocked grains try the diagonals: their preferred side first, then the other one
+    RowBits movedLeft = {};
+    RowBits movedRight = {};
+    if (anyRest) {
+        RowBits leftFirst = {};
+        for (int k = wordLo; k <= wordHi; ++k) {
+            if (rest[k]) {
+                leftFirst[k] = random(k * 64, y, SALT_POWDER_ROW);
             }
-            
-            const auto& props = MATERIAL_PROPERTIES[static_cast<std::size_t>(current)];
-            
-            // Fire interactions with flammable materials
-            if (current == MaterialType::Fire) {
-                // Check surrounding cells for flammable materials
-                for (int dy = -1; dy <= 1; ++dy) {
-                    for (int dx = -1; dx <= 1; ++dx) {
-                        // Skip the fire itself
-                        if (dx == 0 && dy == 0) continue;
-                        
-                        int nx = x + dx;
-                        int ny = y + dy;
-                        
-                        // Skip out of bounds
-                        if (nx < 0 || nx >= WIDTH || ny < 0 || ny >= HEIGHT) continue;
-                        
-                        int neighborIdx = ny * WIDTH + nx;
-                        if (neighborIdx < 0 || neighborIdx >= static_cast<int>(m_grid.size())) continue;
-                        
-                        MaterialType neighbor = m_grid[neighborIdx];
-                        const auto& neighborProps = MATERIAL_PROPERTIES[static_cast<std::size_t>(neighbor)];
-                        
-                        // If neighbor is flammable, chance to ignite it
-                        if (neighborProps.isFlammable && (m_rng() % 20) == 0) {
-                            m_grid[neighborIdx] = MaterialType::Fire;
-                            anyMaterialMoved = true;
-                        }
-                    }
-                }
-                
-                // Fire has chance to burn out
-                if ((m_rng() % 100) < 2) {
-                    m_grid[idx] = MaterialType::Empty;
-                    anyMaterialMoved = true;
-                }
+        }
+        
+        for (int round = 0; round < 2; ++round) {
+            RowBits wantLeft = {};
+            RowBits wantRight = {};
+            for (int k = wordLo; k <= wordHi; ++k) {
+                uint64_t side = (round == 0) ? leftFirst[k] : ~leftFirst[k];
+                wantLeft[k] = rest[k] & side & towardHigherX(below.empty, k, haloBelowLeft);
+                wantRight[k] = rest[k] & ~side & towardLowerX(below.empty, k, haloBelowRight);
             }
             
-            // Water and lava interactions
-            if (current == MaterialType::Water || current == MaterialType::Lava) {
-                // Check surrounding cells for water-lava interactions
-                for (int dy = -1; dy <= 1; ++dy) {
-                    for (int dx = -1; dx <= 1; ++dx) {
-                        // Skip the current cell
-                        if (dx == 0 && dy == 0) continue;
-                        
-                        int nx = x + dx;
-                        int ny = y + dy;
-                        
-                        // Skip out of bounds
-                        if (nx < 0 || nx >= WIDTH || ny < 0 || ny >= HEIGHT) continue;
-                        
-                        int neighborIdx = ny * WIDTH + nx;
-                        if (neighborIdx < 0 || neighborIdx >= static_cast<int>(m_grid.size())) continue;
-                        
-                        MaterialType neighbor = m_grid[neighborIdx];
-                        
-                        // Water + Lava = Stone (water cools lava)
-                        if ((current == MaterialType::Water && neighbor == MaterialType::Lava) ||
-                            (current == MaterialType::Lava && neighbor == MaterialType::Water)) {
-                            // 50% chance for obsidian (Stone) where the water was
-                            if (current == MaterialType::Water) {
-                                m_grid[idx] = MaterialType::Stone;
-                            } else {
-                                m_grid[neighborIdx] = MaterialType::Stone;
-                            }
-                            anyMaterialMoved = true;
-                        }
-                    }
-                }
+            // A cell wanted from both sides goes to the grain on its right, which the
+            // scalar right-to-left sweep would have reached first
+            RowBits leftTargets = {};
+            RowBits rightTargets = {};
+            for (int k = wordLo; k <= wordHi; ++k) {
+                leftTargets[k] = towardLowerX(wantLeft, k);
+                rightTargets[k] = towardHigherX(wantRight, k);
             }
-            
-            // Oil can be ignited by nearby fire
-            if (current == MaterialType::Oil) {
-                // Check surrounding cells for fire
-                for (int dy = -1; dy <= 1; ++dy) {
-                    for (int dx = -1; dx <= 1; ++dx) {
-                        // Skip the oil itself
-                        if (dx == 0 && dy == 0) continue;
-                        
-                        int nx = x + dx;
-                        int ny = y + dy;
-                        
-                        // Skip out of bounds
-                        if (nx < 0 || nx >= WIDTH || ny < 0 || ny >= HEIGHT) continue;
-                        
-                        int neighborIdx = ny * WIDTH + nx;
-                        if (neighborIdx < 0 || neighborIdx >= static_cast<int>(m_grid.size())) continue;
-                        
-                        MaterialType neighbor = m_grid[neighborIdx];
-                        
-                        // If neighbor is fire, oil catches fire
-                        if (neighbor == MaterialType::Fire && (m_rng() % 10) == 0) {
-                            m_grid[idx] = MaterialType::Fire;
-                            anyMaterialMoved = true;
-                            break;
-                        }
-                    }
-                }
+            RowBits contested = {};
+            for (int k = wordLo; k <= wordHi; ++k) {
+                contested[k] = leftTargets[k] & rightTargets[k];
+            }
+            for (int k = wordLo; k <= wordHi; ++k) {
+                wantRight[k] &= ~towardLowerX(contested, k);
+            }
+            for (int k = wordLo; k <= wordHi; ++k) {
+                rightTargets[k] = towardHigherX(wantRight, k);
             }
             
-            // Flammable gas behavior
-            if (current == MaterialType::FlammableGas) {
-                // Check surrounding cells for fire
-                for (int dy = -1; dy <= 1; ++dy) {
-                    for (int dx = -1; dx <= 1; ++dx) {
-                        // Skip the gas itself
-                        if (dx == 0 && dy == 0) continue;
-                        
-                        int nx = x + dx;
-                        int ny = y + dy;
-                        
-                        // Skip out of bounds
-                        if (nx < 0 || nx >= WIDTH || ny < 0 || ny >= HEIGHT) continue;
-                        
-                        int neighborIdx = ny * WIDTH + nx;
-                        if (neighborIdx < 0 || neighborIdx >= static_cast<int>(m_grid.size())) continue;
-                        
-                        MaterialType neighbor = m_grid[neighborIdx];
-                        
-                        // If neighbor is fire, gas explodes
-                        if (neighbor == MaterialType::Fire) {
-                            // Set gas and surrounding area to fire
-                            m_grid[idx] = MaterialType::Fire;
-                            
-                            // Create mini explosion
-                            for (int ey = -2; ey <= 2; ++ey) {
-                                for (int ex = -2; ex <= 2; ++ex) {
-                                    int explosionX = x + ex;
-                                    int explosionY = y + ey;
-                                    
-                                    if (explosionX < 0 || explosionX >= WIDTH || explosionY < 0 || explosionY >= HEIGHT) continue;
-                                    
-                                    int explosionIdx = explosionY * WIDTH + explosionX;
-                                    if (explosionIdx < 0 || explosionIdx >= static_cast<int>(m_grid.size())) continue;
-                                    
-                                    // Don't affect solid blocks
-                                    MaterialType targetMaterial = m_grid[explosionIdx];
-                                    const auto& targetProps = MATERIAL_PROPERTIES[static_cast<std::size_t>(targetMaterial)];
-                                    
-                                    if (!targetProps.isSolid || (m_rng() % 3) == 0) {
-                                        m_grid[explosionIdx] = MaterialType::Fire;
-                                    }
-                                }
-                            }
-                            
-                            anyMaterialMoved = true;
-                            break;
-                        }
-                    }
-                }
+            for (int k = wordLo; k <= wordHi; ++k) {
+                below.empty[k] &= ~(leftTargets[k] | rightTargets[k]);
+                rest[k] &= ~(wantLeft[k] | wantRight[k]);
+                movedLeft[k] |= wantLeft[k];
+                movedRight[k] |= wantRight[k];
+            }
+        }
+    }
+    
+    // Apply the moves to the cells
+    for (int k = wordLo; k <= wordHi; ++k) {
+        const uint64_t vacated = fall[k] | movedLeft[k] | movedRight[k];
+        const int rowStart = cellIndex(k * 64, y);
+        
+        // Cells that fell further than the row below, queued together after the word
+        DirtyRect landed;
+        uint64_t landedTiles = 0;
+        for (uint64_t bits = fall[k]; bits; bits &= bits - 1) {
+            // The cell below is free; a grain with speed keeps going through its column
+            const int x = k * 64 + lowestBit(bits);
+            const int idx = rowStart + lowestBit(bits);
+            const int speed = std::min(m_cells[idx].velocity + 1, Physics::MAX_FALL_SPEED);
+            const int distance = (speed > 1) ? fallDistance(idx, y, speed) : 1;
+            Cell& fallen = moveGrain(x, y, x, y + distance);
+            fallen.velocity = static_cast<int8_t>(speed);
+            if (distance > 1) {
+                addCellNeighbourhood(x, y + distance, landed, landedTiles);
+            }
+        }
+        markDirty(landed, landedTiles);
+        for (uint64_t bits = movedLeft[k]; bits; bits &= bits - 1) {
+            const int x = k * 64 + lowestBit(bits);
+            moveGrain(x, y, x - 1, y + 1);
+        }
+        for (uint64_t bits = movedRight[k]; bits; bits &= bits - 1) {
+            const int x = k * 64 + lowestBit(bits);
+            moveGrain(x, y, x + 1, y + 1);
+        }
+        
+        // Blocked grains over a liquid or gas sink through it if it is lighter
+        uint64_t sunk = 0;
+        for (uint64_t bits = rest[k] & below.fluid[k]; bits; bits &= bits - 1) {
+            const int idx = rowStart + lowestBit(bits);
+            if (g_displacement.canDisplace(m_cells[idx].material, m_cells[idx + STRIDE].material)) {
+                swapCells(idx, idx + STRIDE, m_fallStamp);
+                m_cells[idx + STRIDE].freeFalling = true;
+                m_cells[idx + STRIDE].velocity = 0;
+                sunk |= bits & (~bits + 1);
             }
         }
+        rest[k] &= ~sunk;
+        
+        // Grains that stayed put come to rest
+        for (uint64_t bits = rest[k] & moving[k]; bits; bits &= bits - 1) {
+            Cell& settled = m_cells[rowStart + lowestBit(bits)];
+            settled.velocity = 0;
+            settled.freeFalling = false;
+        }
+        
+        if (const uint64_t moved = vacated | sunk) {
+            // A word is one tile wide, so its outermost moved cells cover everyone's
+            // neighbourhood in both the dirty rect and the tile bitmap
+            markCellDirty(k * 64 + lowestBit(moved), y);
+            markCellDirty(k * 64 + highestBit(moved), y);
+            anyMaterialMoved = true;
+        }
+        
+        // Row y becomes the row below for the next (upper) row; sunk grains left the fluid
+        // they swapped with in their place
+        below.empty[k] = empty[k] | vacated;
+        below.fluid[k] = fluid[k] | sunk;
     }
+    return true;
 }
 
-void Chunk::updatePixelData() {
-    // Update pixel data for all cells in the chunk
-    for (int y = 0; y < HEIGHT; ++y) {
-        for (int x = 0; x < WIDTH; ++x) {
-            int idx = y * WIDTH + x;
-            MaterialType material = m_grid[idx];
-            int pixelIdx = idx * 4;
-            
-            if (material == MaterialType::Empty) {
-                // Empty cells are transparent
-                m_pixelData[pixelIdx] = 0;
-                m_pixelData[pixelIdx+1] = 0;
-                m_pixelData[pixelIdx+2] = 0;
-                m_pixelData[pixelIdx+3] = 0;
-            } else {
-                const auto& props = MATERIAL_PROPERTIES[static_cast<std::size_t>(material)];
-                
-                // Create a position-based variation for more natural look
-                // Enhanced variation using multiple hash functions for more texture
-                int posHash1 = ((x * 13) + (y * 7)) % 32;
-                int posHash2 = ((x * 23) + (y * 17)) % 64;
-                int posHash3 = ((x * 5) + (y * 31)) % 16;
-                
-                // Different variation for each color channel - MODERATE VARIATION
-                int rVariation = ((posHash1 % 35) - 17) * 2;  // Moderate variation
-                int gVariation = ((posHash2 % 31) - 15) * 2;  // Moderate variation
-                int bVariation = ((posHash3 % 27) - 13) * 2;  // Moderate variation
+void Chunk::updateFused(bool& anyMaterialMoved) {
+    // One bottom-up sweep over the dirty rect that dispatches every cell through
+    // g_materialTraits. Each row runs the steps of the multi-pass update while it is still in
+    // cache: powders and liquid falls, then liquid spreading. Gases rise FUSED_GAS_LAG rows
+    // behind the sweep and reactions follow FUSED_REACTION_LAG rows behind, so both see rows
+    // that have finished moving for this update, as they would after the separate passes.
+    const int minX = m_dirtyRect.minX;
+    const int maxX = m_dirtyRect.maxX;
+    const int minY = m_dirtyRect.minY;
+    const int maxY = m_dirtyRect.maxY;
+    const bool bitboardPowders = (s_powderKernel == PowderKernel::Bitboard);
+    RowCells below;
+    
+    // Moves reach one row past the dirty rect on either side, and so do reactions
+    int reactionRow = std::min(HEIGHT - 1, maxY + 1);
+    const int lastReactionRow = std::max(0, minY - 1);
+    
+    for (int y = maxY; y >= minY - FUSED_GAS_LAG; --y) {
+        const uint32_t rowTiles = (y >= minY) ? tileRowMask(m_awakeTiles, y) : 0;
+        if (rowTiles != 0) {
+            // Powders and liquid falls, right to left like the scalar powder pass. Liquid
+            // spreading runs later, so the row below must be rebuilt for the bitboard kernel.
+            if (bitboardPowders) {
+                updatePowderRowBitboard(y, below, false, anyMaterialMoved);
+            }
+            for (int x = maxX; x >= minX; --x) {
+                if (!isTileAwake(rowTiles, x)) {
+                    x &= ~(TILE_SIZE - 1); // Skip the rest of this sleeping tile
+                    continue;
+                }
                 
-                // Apply material-specific variation patterns
-                // Various materials have their own unique texture patterns
-                switch (material) {
-                    case MaterialType::Stone:
-                        // Stone has gray variations with strong texture
-                        rVariation = gVariation = bVariation = ((posHash1 % 45) - 22) * 5;
-                        // Add dark speckles
-                        if (posHash2 % 5 == 0) {
-                            rVariation -= 50;
-                            gVariation -= 50;
-                            bVariation -= 50;
-                        }
-                        break;
-                    case MaterialType::Grass:
-                        // Grass has strong green variations with patches
-                        gVariation = ((posHash1 % 50) - 15) * 5; // 5x stronger green variation
-                        rVariation = ((posHash2 % 25) - 15) * 5; // 5x stronger yellowish tints
-                        // Add occasional darker patches
-                        if (posHash1 % 3 == 0) {
-                            gVariation -= 60;
-                            rVariation -= 40;
-                        }
-                        break;
-                    case MaterialType::Sand:
-                        // Sand has strong yellow-brown variations with visible texture
-                        rVariation = (posHash1 % 30) - 10;
-                        gVariation = (posHash1 % 25) - 12;
-                        bVariation = (posHash3 % 15) - 10;
-                        // Add occasional darker grains
-                        if (posHash2 % 4 == 0) {
-                            rVariation -= 15;
-                            gVariation -= 15;
-                        }
-                        break;
-                    case MaterialType::Dirt:
-                        // Dirt has rich brown variations with texture
-                        rVariation = (posHash1 % 40) - 15;
-                        gVariation = (posHash2 % 30) - 15;
-                        bVariation = (posHash3 % 20) - 12;
-                        // Add occasional darker and lighter patches
-                        if (posHash2 % 5 == 0) {
-                            rVariation -= 20;
-                            gVariation -= 20;
-                            bVariation -= 10;
-                        } else if (posHash2 % 7 == 0) {
-                            rVariation += 15;
-                            gVariation += 10;
-                        }
-                        break;
-                    case MaterialType::Snow:
-                        // Snow has very subtle blue-white variations
-                        rVariation = gVariation = bVariation = (posHash1 % 7) - 3;
-                        break;
-                    case MaterialType::Sandstone:
-                        // Sandstone has beige-tan variations
-                        rVariation = (posHash1 % 16) - 8;
-                        gVariation = (posHash2 % 14) - 7;
-                        bVariation = (posHash3 % 8) - 4;
-                        break;
-                    case MaterialType::Bedrock:
-                        // Bedrock has dark gray variations with some texture
-                        rVariation = gVariation = bVariation = (posHash1 % 20) - 8;
-                        // Add some occasional darker spots for texture
-                        if (posHash2 % 8 == 0) {
-                            rVariation -= 10;
-                            gVariation -= 10;
-                            bVariation -= 10;
-                        }
-                        break;
-                    case MaterialType::Gravel:
-                        // Gravel has strong texture with varied gray tones
-                        rVariation = gVariation = bVariation = (posHash1 % 35) - 17;
-                        // Add mixed size pebble effect
-                        if (posHash2 % 7 == 0) {
-                            rVariation -= 25;
-                            gVariation -= 25;
-                            bVariation -= 25;
-                        } else if (posHash2 % 11 == 0) {
-                            rVariation += 15;
-                            gVariation += 15;
-                            bVariation += 15;
-                        }
-                        break;
-                    case MaterialType::TopSoil:
-                        // Topsoil has rich brown variations with organic texture
-                        rVariation = (posHash1 % 25) - 10;
-                        gVariation = (posHash2 % 20) - 10;
-                        bVariation = (posHash3 % 12) - 6;
-                        // Add darker organic matter patches
-                        if (posHash2 % 4 == 0) {
-                            rVariation -= 15;
-                            gVariation -= 12;
-                            bVariation -= 5;
-                        }
-                        break;
-                    case MaterialType::DenseRock:
-                        // Dense rock has dark blue-gray coloration with crystalline texture
-                        rVariation = (posHash1 % 18) - 9;
-                        gVariation = (posHash1 % 18) - 9;
-                        bVariation = (posHash1 % 22) - 9; // Slight blue tint
-                        // Add occasional mineral veins or crystalline structures
-                        if (posHash2 % 9 == 0) {
-                            rVariation += 10;
-                            gVariation += 12;
-                            bVariation += 15; // Blueish highlights
-                        } else if (posHash2 % 16 == 0) {
-                            rVariation -= 15;
-                            gVariation -= 15;
-                            bVariation -= 10; // Dark patches
-                        }
-                        break;
-                    case MaterialType::Water:
-                        // Water has blue variations with some subtle waves
-                        bVariation = (posHash1 % 18) - 9;
-                        // Slight green tint variations for depth perception
-                        gVariation = (posHash2 % 10) - 5;
-                        // Very minimal red variation
-                        rVariation = (posHash3 % 4) - 2;
-                        break;
-                    case MaterialType::Lava:
-                        // Lava has hot red-orange variations with bright spots
-                        rVariation = (posHash1 % 30) - 5; // More red, less reduction
-                        gVariation = (posHash2 % 25) - 15; // More variation in orange
-                        bVariation = (posHash3 % 6) - 3; // Minor blue variation
-                        // Add occasional bright yellow-white spots
-                        if (posHash2 % 10 == 0) {
-                            rVariation += 20;
-                            gVariation += 15;
-                        }
-                        break;
-                    case MaterialType::GrassStalks:
-                        // Grass stalks have varied green shades
-                        gVariation = (posHash1 % 22) - 8; // Strong green variation
-                        rVariation = (posHash2 % 10) - 5; // Some red variation for yellowish/brownish tints
-                        bVariation = (posHash3 % 8) - 4; // Minor blue variation
-                        break;
-                    case MaterialType::Fire:
-                        // Fire has flickering yellow-orange-red variations
-                        rVariation = (posHash1 % 20) - 5; // Strong red
-                        gVariation = (posHash2 % 30) - 15; // Varied green for yellow/orange
-                        bVariation = (posHash3 % 10) - 8; // Minimal blue
-                        // Random bright spots
-                        if (posHash2 % 5 == 0) {
-                            rVariation += 15;
-                            gVariation += 10;
-                        }
-                        break;
-                    case MaterialType::Oil:
-                        // Oil has dark brown-black variations with slight shine
-                        rVariation = (posHash1 % 12) - 8;
-                        gVariation = (posHash2 % 10) - 7;
-                        bVariation = (posHash3 % 8) - 6;
-                        // Occasional slight shine
-                        if (posHash2 % 12 == 0) {
-                            rVariation += 8;
-                            gVariation += 8;
-                            bVariation += 8;
-                        }
-                        break;
-                    case MaterialType::FlammableGas:
-                        // Flammable gas has subtle greenish variations with transparency
-                        gVariation = (posHash1 % 15) - 5;
-                        rVariation = (posHash2 % 8) - 4;
-                        bVariation = (posHash3 % 8) - 4;
-                        break;
-                        
-                    // Ore material texture variations
-                    case MaterialType::IronOre:
-                        // Iron ore has gray-blue tints with metallic specks
-                        rVariation = gVariation = (posHash1 % 25) - 12;
-                        bVariation = (posHash1 % 30) - 12;
-                        // Add metallic highlights
-                        if (posHash2 % 4 == 0) {
-                            rVariation += 25;
-                            gVariation += 25;
-                            bVariation += 30;
-                        }
-                        break;
-                        
-                    case MaterialType::CopperOre:
-                        // Copper has orange-brown coloration with patchy texture
-                        rVariation = (posHash1 % 40) - 10;  // Strong orange-red variation
-                        gVariation = (posHash2 % 25) - 15;  // Less green variation
-                        bVariation = (posHash3 % 15) - 10;  // Minimal blue
-                        // Add verdigris tint patches
-                        if (posHash2 % 6 == 0) {
-                            rVariation -= 10;
-                            gVariation += 15;
-                            bVariation += 5;
-                        }
-                        break;
-                        
-                    case MaterialType::GoldOre:
-                        // Gold has shiny yellow with highlight sparkles
-                        rVariation = (posHash1 % 30) - 10;  // Strong yellow-red
-                        gVariation = (posHash2 % 30) - 15;  // Yellow-green
-                        bVariation = (posHash3 % 10) - 8;   // Minimal blue
-                        // Add shiny spots
-                        if (posHash2 % 4 == 0) {
-                            rVariation += 30;
-                            gVariation += 20;
-                        }
-                        break;
-                        
-                    case MaterialType::CoalOre:
-                        // Coal has dark with occasional shiny bits
-                        rVariation = gVariation = bVariation = (posHash1 % 12) - 9;  // Generally dark
-                        // Add occasional shiny anthracite highlights
-                        if (posHash2 % 7 == 0) {
-                            rVariation += 20;
-                            gVariation += 20;
-                            bVariation += 20;
-                        }
-                        break;
-                        
-                    case MaterialType::DiamondOre:
-                        // Diamond has blue-white sparkles in dark matrix
-                        rVariation = (posHash1 % 20) - 10;
-                        gVariation = (posHash2 % 25) - 10;
-                        bVariation = (posHash3 % 35) - 10;  // More blue variation
-                        // Add bright sparkles
-                        if (posHash2 % 3 == 0) {
-                            rVariation += 30;
-                            gVariation += 40;
-                            bVariation += 50;
-                        }
-                        break;
-                        
-                    case MaterialType::SilverOre:
-                        // Silver has white-gray with metallic sheen
-                        rVariation = gVariation = bVariation = (posHash1 % 30) - 15;
-                        // Add reflective highlights
-                        if (posHash2 % 5 == 0) {
-                            rVariation += 30;
-                            gVariation += 30;
-                            bVariation += 35;  // Slightly blue tint to highlights
-                        }
-                        break;
-                        
-                    case MaterialType::EmeraldOre:
-                        // Emerald has vivid green with internal facets
-                        rVariation = (posHash1 % 15) - 10;  // Little red
-                        gVariation = (posHash2 % 45) - 15;  // Strong green variation
-                        bVariation = (posHash3 % 20) - 15;  // Some blue variation
-                        // Add crystal facet highlights
-                        if (posHash2 % 6 == 0) {
-                            rVariation += 5;
-                            gVariation += 35;
-                            bVariation += 10;
-                        }
-                        break;
-                        
-                    case MaterialType::SapphireOre:
-                        // Sapphire has deep blue with lighter facets
-                        rVariation = (posHash1 % 15) - 12;  // Minimal red
-                        gVariation = (posHash2 % 20) - 15;  // Some green
-                        bVariation = (posHash3 % 50) - 15;  // Strong blue variation
-                        // Add facet highlights
-                        if (posHash2 % 5 == 0) {
-                            rVariation += 5;
-                            gVariation += 15;
-                            bVariation += 40;
-                        }
-                        break;
-                        
-                    case MaterialType::RubyOre:
-                        // Ruby has deep red with bright facets
-                        rVariation = (posHash1 % 50) - 15;  // Strong red variation
-                        gVariation = (posHash2 % 15) - 12;  // Minimal green
-                        bVariation = (posHash3 % 15) - 12;  // Minimal blue
-                        // Add facet highlights
-                        if (posHash2 % 5 == 0) {
-                            rVariation += 40;
-                            gVariation += 5;
-                            bVariation += 10;
-                        }
-                        break;
-                        
-                    case MaterialType::SulfurOre:
-                        // Sulfur has bright yellow with matrix patterns
-                        rVariation = (posHash1 % 35) - 10;  // Strong red-yellow
-                        gVariation = (posHash2 % 35) - 10;  // Strong green-yellow
-                        bVariation = (posHash3 % 10) - 8;   // Minimal blue
-                        // Add darker matrix
-                        if (posHash2 % 4 == 0) {
-                            rVariation -= 30;
-                            gVariation -= 30;
-                        }
-                        break;
-                        
-                    case MaterialType::QuartzOre:
-                        // Quartz has white-clear crystal in gray matrix
-                        rVariation = gVariation = bVariation = (posHash1 % 25) - 12;
-                        // Add bright white crystal
-                        if (posHash2 % 3 == 0) {
-                            rVariation += 35;
-                            gVariation += 35;
-                            bVariation += 35;
+                const Cell& cell = m_cells[cellIndex(x, y)];
+                switch (g_materialTraits.movementOf(cell.material)) {
+                    case CellBehavior::Powder:
+                        if (!bitboardPowders) {
+                            stepPowder(x, y, anyMaterialMoved);
                         }
                         break;
-                        
-                    case MaterialType::UraniumOre:
-                        // Uranium has greenish glow spots in dark matrix
-                        rVariation = (posHash1 % 15) - 10;  // Limited red
-                        gVariation = (posHash2 % 40) - 15;  // Strong green variation
-                        bVariation = (posHash3 % 15) - 12;  // Limited blue
-                        // Add glowing spots
-                        if (posHash2 % 4 == 0) {
-                            rVariation += 5;
-                            gVariation += 60;  // Very bright green glow
-                            bVariation += 10;
+                    case CellBehavior::Liquid:
+                        if (cell.moveStamp != m_fallStamp) {
+                            stepLiquidFall(x, y, anyMaterialMoved);
                         }
                         break;
-                        
                     default:
-                        // Default variation - still apply some texture for any other materials
-                        rVariation = (posHash1 % 12) - 6;
-                        gVariation = (posHash2 % 12) - 6;
-                        bVariation = (posHash3 % 12) - 6;
                         break;
                 }
+            }
+            
+            // Liquid spreading, once in each direction
+            for (int iteration = 0; iteration < 2; ++iteration) {
+                bool leftToRight = (iteration == 0);
                 
-                // Apply the enhanced variation to the base color
-                int r = props.r + rVariation + props.varR;
-                int g = props.g + gVariation + props.varG;
-                int b = props.b + bVariation + props.varB;
-                
-                // Clamp values to valid range
-                m_pixelData[pixelIdx] = std::max(0, std::min(255, r));
-                m_pixelData[pixelIdx+1] = std::max(0, std::min(255, g));
-                m_pixelData[pixelIdx+2] = std::max(0, std::min(255, b));
-                m_pixelData[pixelIdx+3] = props.transparency;
+                for (int i = minX; i <= maxX; ++i) {
+                    int x = leftToRight ? i : (maxX - (i - minX));
+                    if (!isTileAwake(rowTiles, x)) {
+                        // Skip to the far edge of this sleeping tile in the current direction
+                        int edge = leftToRight ? (x | (TILE_SIZE - 1)) : (x & ~(TILE_SIZE - 1));
+                        i = leftToRight ? edge : (maxX - (edge - minX));
+                        continue;
+                    }
+                    
+                    const Cell& cell = m_cells[cellIndex(x, y)];
+                    if (g_materialTraits.movementOf(cell.material) == CellBehavior::Liquid &&
+                        cell.moveStamp != m_spreadStamp) {
+                        stepLiquidSpread(x, y, leftToRight, anyMaterialMoved);
+                    }
+                }
             }
         }
+        
+        const int gasRow = y + FUSED_GAS_LAG;
+        if (gasRow >= minY && gasRow <= maxY) {
+            riseGasRowFused(gasRow, anyMaterialMoved);
+        }
+        
+        // Rows from y + FUSED_GAS_LAG down are final, so reactions can run up to there
+        for (; reactionRow >= std::max(lastReactionRow, y + FUSED_REACTION_LAG); --reactionRow) {
+            reactRowFused(reactionRow, anyMaterialMoved);
+        }
     }
     
-    // Mark chunk as clean after updating
-    m_isDirty = false;
+    for (; reactionRow >= lastReactionRow; --reactionRow) {
+        reactRowFused(reactionRow, anyMaterialMoved);
+    }
+}
+
+void Chunk::riseGasRowFused(int y, bool& anyMaterialMoved) {
+    // updateGases walks top-down, so a gas right below another one can follow it up in the
+    // same update. Rows arrive bottom-up here: such a gas waits, and the one above pulls it
+    // along once it has risen.
+    const int minX = m_dirtyRect.minX;
+    const int maxX = m_dirtyRect.maxX;
+    const int maxY = m_dirtyRect.maxY;
+    const uint32_t rowTiles = tileRowMask(m_awakeTiles, y);
+    if (rowTiles == 0) return;
+    
+    auto canRise = [this](int x, int cy) {
+        const Cell& cell = m_cells[cellIndex(x, cy)];
+        return g_materialTraits.movementOf(cell.material) == CellBehavior::Gas &&
+               cell.moveStamp != m_fallStamp && cell.moveStamp != m_spreadStamp;
+    };
+    
+    for (int x = minX; x <= maxX; ++x) {
+        if (!isTileAwake(rowTiles, x)) {
+            x |= TILE_SIZE - 1; // Skip the rest of this sleeping tile
+            continue;
+        }
+        if (!canRise(x, y) || canRise(x, y - 1)) {   // Row -1 is the halo
+            continue;
+        }
+        
+        // Rise, then let the gases waiting underneath follow
+        for (int cy = y; cy <= maxY && isTileAwake(tileRowMask(m_awakeTiles, cy), x); ++cy) {
+            if ((cy > y && !canRise(x, cy)) || !stepGas(x, cy, anyMaterialMoved)) {
+                break;
+            }
+        }
+    }
+}
+
+void Chunk::reactRowFused(int y, bool& anyMaterialMoved) {
+    if (m_reactiveCells.load(std::memory_order_relaxed) == 0) return;
+    
+    // Same region as handleMaterialInteractions: the scanned rect plus everything moved so far
+    DirtyRect region = m_dirtyRect;
+    region.include(m_nextDirtyRect.load());
+    if (y < region.minY || y > region.maxY) return;
+    const uint32_t rowTiles = tileRowMask(m_awakeTiles | getNextAwakeTiles(), y);
+    if (rowTiles == 0) return;
+    
+    for (int x = region.minX; x <= region.maxX; ++x) {
+        if (!isTileAwake(rowTiles, x)) {
+            x |= TILE_SIZE - 1; // Skip the rest of this sleeping tile
+            continue;
+        }
+        reactCell(x, y, anyMaterialMoved);
+    }
+}
+
+void Chunk::handleMaterialInteractions(bool& anyMaterialMoved) {
+    // Nothing here can react (a chunk of stone and sand, say): skip the sweep
+    if (m_reactiveCells.load(std::memory_order_relaxed) == 0) {
+        return;
+    }
+    
+    // Process the scanned region plus everything that moved into place this frame
+    DirtyRect region = m_dirtyRect;
+    region.include(m_nextDirtyRect.load());
+    const uint64_t tiles = m_awakeTiles | getNextAwakeTiles();
+    
+    for (int y = region.minY; y <= region.maxY; ++y) {
+        const uint32_t rowTiles = tileRowMask(tiles, y);
+        if (rowTiles == 0) continue;
+        
+        for (int x = region.minX; x <= region.maxX; ++x) {
+            if (!isTileAwake(rowTiles, x)) {
+                x |= TILE_SIZE - 1; // Skip the rest of this sleeping tile
+                continue;
+            }
+            
+            reactCell(x, y, anyMaterialMoved);
+        }
+    }
+}
+
+void Chunk::recountReactiveCells() {
+    int count = 0;
+    for (const Cell& cell : m_cells) {
+        count += isReactive(cell.material);
+    }
+    m_reactiveCells.store(count, std::memory_order_relaxed);
+}
+
+void Chunk::applyReactions(int x, int y, bool& anyMaterialMoved) {
+    const int idx = cellIndex(x, y);
+    const MaterialType material = m_cells[idx].material;
+    const MaterialDecay& decay = g_reactions.decayOf(material);
+    
+    // Decaying cells stay active until they are gone
+    if (decay.percent != 0) {
+        markCellDirty(x, y);
+    }
+    
+    // Neighbours are read through the halo, so cells react across chunk borders; what lands
+    // in the halo is passed on by flushHalo
+    for (int dy = -1; dy <= 1; ++dy) {
+        for (int dx = -1; dx <= 1; ++dx) {
+            if (dx == 0 && dy == 0) continue;
+            
+            const int neighborIdx = cellIndex(x + dx, y + dy);
+            const ReactionRule& rule = g_reactions.rule(material, m_cells[neighborIdx].material);
+            if (rule.chance == 0 ||
+                (rule.chance > 1 && random(x, y, SALT_REACTION + neighbourIndex(dx, dy)) % rule.chance != 0)) {
+                continue;
+            }
+            
+            if (rule.neighborProduct != m_cells[neighborIdx].material) {
+                writeCell(neighborIdx, Cell(rule.neighborProduct));
+                markCellDirty(x + dx, y + dy);
+            }
+            anyMaterialMoved = true;
+            if (rule.product == material) {
+                continue;
+            }
+            
+            writeCell(idx, Cell(rule.product));
+            markCellDirty(x, y);
+            
+            // The burst stops at the halo, one cell past the chunk. Solids only give way on a
+            // 1 in 3 roll.
+            for (int by = std::max(-1, y - rule.blast); rule.blast != 0 && by <= std::min(HEIGHT, y + rule.blast); ++by) {
+                for (int bx = std::max(-1, x - rule.blast); bx <= std::min(WIDTH, x + rule.blast); ++bx) {
+                    const int blastIdx = cellIndex(bx, by);
+                    if (!MaterialRegistry::tables().is(m_cells[blastIdx].material, MATERIAL_SOLID) || random(bx, by, SALT_EXPLOSION) % 3 == 0) {
+                        writeCell(blastIdx, Cell(rule.product));
+                        markCellDirty(bx, by);
+                    }
+                }
+            }
+            
+            // The cell is something else now: its old rules no longer apply
+            return;
+        }
+    }
+    
+    if (decay.percent == 0) {
+        return;
+    }
+    // Only materials with a lifetime run out of life; the rest decay on the roll alone
+    Cell& cell = m_cells[idx];
+    if (cell.life > 0) {
+        cell.life--;
+    }
+    const bool expired = cell.life == 0 && MaterialRegistry::tables().lifetime[static_cast<std::size_t>(material)] != 0;
+    if (expired || random(x, y, SALT_DECAY) % 100 < decay.percent) {
+        writeCell(idx, Cell(decay.product));
+        anyMaterialMoved = true;
+        markCellDirty(x, y);
+    }
+}
+
+void Chunk::updatePixelData() {
+    m_changedPixelRows.fill(~uint64_t(0));
+    updateChangedPixels();
+}
+
+void Chunk::markPixelsChanged(int x0, int y, int x1) {
+    for (int tileX = x0 / TILE_SIZE; tileX <= x1 / TILE_SIZE; ++tileX) {
+        markPixelChanged(tileX * TILE_SIZE, y);
+    }
+}
+
+void Chunk::updateChangedPixels() {
+    // Row by row, so a row changed across neighbouring tiles is colourized as one run
+    for (int tileY = 0; tileY < TILES_Y; ++tileY) {
+        uint64_t* rowMasks = &m_changedPixelRows[tileY * TILES_X];
+        uint64_t anyRows = 0;
+        for (int tileX = 0; tileX < TILES_X; ++tileX) {
+            anyRows |= rowMasks[tileX];
+        }
+        
+        for (uint64_t bits = anyRows; bits != 0; bits &= bits - 1) {
+            const int row = lowestBit(bits);
+            const int y = tileY * TILE_SIZE + row;
+            int tileX = 0;
+            while (tileX < TILES_X) {
+                if (!((rowMasks[tileX] >> row) & 1)) {
+                    ++tileX;
+                    continue;
+                }
+                int end = tileX + 1;
+                while (end < TILES_X && ((rowMasks[end] >> row) & 1)) {
+                    ++end;
+                }
+                const int x = tileX * TILE_SIZE;
+                MaterialPalette::colorizeRow(&m_cells[cellIndex(x, y)], (end - tileX) * TILE_SIZE, x, y,
+                                             &m_pixelData[(y * WIDTH + x) * 4]);
+                tileX = end;
+            }
+        }
+        
+        for (int tileX = 0; tileX < TILES_X; ++tileX) {
+            m_recoloredRows[tileY * TILES_X + tileX] |= rowMasks[tileX];
+            rowMasks[tileX] = 0;
+        }
+    }
+}
+
+void Chunk::takePixelChanges(std::vector<DirtyRect>& spans) {
+    for (int tileY = 0; tileY < TILES_Y; ++tileY) {
+        uint64_t* rowMasks = &m_recoloredRows[tileY * TILES_X];
+        int tileX = 0;
+        while (tileX < TILES_X) {
+            const uint64_t rows = rowMasks[tileX];
+            if (rows == 0) {
+                ++tileX;
+                continue;
+            }
+            int end = tileX + 1;
+            while (end < TILES_X && rowMasks[end] == rows) {
+                ++end;
+            }
+            
+            for (uint64_t bits = rows; bits != 0;) {
+                const int first = lowestBit(bits);
+                const uint64_t run = bits >> first;
+                const int count = ~run == 0 ? TILE_SIZE - first : lowestBit(~run);
+                DirtyRect span;
+                span.minX = tileX * TILE_SIZE;
+                span.maxX = end * TILE_SIZE - 1;
+                span.minY = tileY * TILE_SIZE + first;
+                span.maxY = span.minY + count - 1;
+                spans.push_back(span);
+                bits = first + count == TILE_SIZE ? 0 : bits & (~uint64_t(0) << (first + count));
+            }
+            std::fill(rowMasks + tileX, rowMasks + end, 0);
+            tileX = end;
+        }
+    }
 }
 
 bool Chunk::serialize(std::ostream& out) const {
@@ -1470,10 +1746,28 @@ bool Chunk::serialize(std::ostream& out) const {
     out.write(reinterpret_cast<const char*>(&m_posX), sizeof(m_posX));
     out.write(reinterpret_cast<const char*>(&m_posY), sizeof(m_posY));
     
-    // Write chunk grid
-    uint32_t gridSize = static_cast<uint32_t>(m_grid.size());
+    // Write chunk grid (materials first, so older readers still find them in place).
+    // Only the chunk's own cells are saved, row by row; the halo is rebuilt every update.
+    uint32_t gridSize = static_cast<uint32_t>(WIDTH * HEIGHT);
     out.write(reinterpret_cast<const char*>(&gridSize), sizeof(gridSize));
-    out.write(reinterpret_cast<const char*>(m_grid.data()), gridSize * sizeof(MaterialType));
+    std::vector<MaterialType> materials(gridSize);
+    for (uint32_t i = 0; i < gridSize; ++i) {
+        materials[i] = m_cells[cellIndex(i % WIDTH, i / WIDTH)].material;
+    }
+    out.write(reinterpret_cast<const char*>(materials.data()), gridSize * sizeof(MaterialType));
+    
+    // Followed by the per-cell state block: falling flag, velocity and lifetime
+    // (move stamps only matter within one update and are not saved)
+    uint32_t stateVersion = CELL_STATE_VERSION;
+    out.write(reinterpret_cast<const char*>(&stateVersion), sizeof(stateVersion));
+    std::vector<uint8_t> state(gridSize * 3);
+    for (uint32_t i = 0; i < gridSize; ++i) {
+        const Cell& cell = m_cells[cellIndex(i % WIDTH, i / WIDTH)];
+        state[i * 3] = cell.freeFalling;
+        state[i * 3 + 1] = static_cast<uint8_t>(cell.velocity);
+        state[i * 3 + 2] = cell.life;
+    }
+    out.write(reinterpret_cast<const char*>(state.data()), state.size());
     
     // Reset modified flag after serialization
     const_cast<Chunk*>(this)->setModified(false);
@@ -1491,16 +1785,46 @@ bool Chunk::deserialize(std::istream& in) {
     // Read chunk grid
     uint32_t gridSize;
     in.read(reinterpret_cast<char*>(&gridSize), sizeof(gridSize));
-    m_grid.resize(gridSize);
-    in.read(reinterpret_cast<char*>(m_grid.data()), gridSize * sizeof(MaterialType));
+    if (!in.good() || gridSize != static_cast<uint32_t>(WIDTH * HEIGHT)) {
+        return false;
+    }
+    std::vector<MaterialType> materials(gridSize);
+    in.read(reinterpret_cast<char*>(materials.data()), gridSize * sizeof(MaterialType));
+    if (!in.good()) {
+        return false;
+    }
+    for (uint32_t i = 0; i < gridSize; ++i) {
+        m_cells[cellIndex(i % WIDTH, i / WIDTH)] = Cell(materials[i]);
+    }
+    recountReactiveCells();
+    for (int x = 0; x < WIDTH; ++x) {
+        rebuildRunStarts(x);
+    }
+    
+    // Files written before the cell state block existed end here - keep the defaults
+    uint32_t stateVersion = 0;
+    if (in.read(reinterpret_cast<char*>(&stateVersion), sizeof(stateVersion)) &&
+        stateVersion == CELL_STATE_VERSION) {
+        std::vector<uint8_t> state(gridSize * 3);
+        if (in.read(reinterpret_cast<char*>(state.data()), state.size())) {
+            for (uint32_t i = 0; i < gridSize; ++i) {
+                Cell& cell = m_cells[cellIndex(i % WIDTH, i / WIDTH)];
+                cell.freeFalling = state[i * 3] & 1;
+                cell.velocity = static_cast<int8_t>(state[i * 3 + 1]);
+                cell.life = state[i * 3 + 2];
+            }
+        }
+    }
+    in.clear();
     
-    // Update pixel data for rendering
-    updatePixelData();
+    // Every pixel is stale; the next recolour (the chunk's update, or the world copying its
+    // pixels) redoes them all
+    m_changedPixelRows.fill(~uint64_t(0));
     
     // Mark as clean
     setModified(false);
     // But mark as dirty for physics update
-    m_isDirty = true;
+    markAllDirty();
     m_shouldUpdateNextFrame = true;
     
     return in.good();
@@ -1508,6 +1832,15 @@ bool Chunk::deserialize(std::istream& in) {
 
 // World implementation
 
+bool World::loadMaterials(const std::string& path) {
+    if (!MaterialRegistry::loadDefinitions(path)) {
+        return false;
+    }
+    Chunk::rebuildMaterialTables();
+    MaterialPalette::rebuild();
+    return true;
+}
+
 World::World(int width, int height) 
     : m_width(width), m_height(height), m_chunkManager(Chunk::WIDTH) {
     // std::cout << "Creating world with chunk size: " << Chunk::WIDTH << "x" << Chunk::HEIGHT << std::endl;
@@ -1515,64 +1848,107 @@ World::World(int width, int height)
     m_chunksX = (width + Chunk::WIDTH - 1) / Chunk::WIDTH;
     m_chunksY = (height + Chunk::HEIGHT - 1) / Chunk::HEIGHT;
     
-    // Create all chunks (legacy system)
-    m_chunks.resize(m_chunksX * m_chunksY);
+    // Create every chunk of the world up front; the streaming system keeps the active ones
+    // loaded and caches or saves the rest
     for (int y = 0; y < m_chunksY; ++y) {
         for (int x = 0; x < m_chunksX; ++x) {
-            m_chunks[y * m_chunksX + x] = std::make_unique<Chunk>(x * Chunk::WIDTH, y * Chunk::HEIGHT);
-            
-            // Initially initialize chunk manager too
-            // This will be replaced with dynamic loading/unloading later
             m_chunkManager.getChunk(x, y, true);
         }
     }
     
+    // One dirty bit per processing chunk
+    m_tilesX = (width + PROCESSING_CHUNK_SIZE - 1) / PROCESSING_CHUNK_SIZE;
+    int tilesY = (height + PROCESSING_CHUNK_SIZE - 1) / PROCESSING_CHUNK_SIZE;
+    m_dirtyTiles.assign((m_tilesX * tilesY + 63) / 64, 0);
+    
     // Initialize pixel data for rendering
     m_pixelData.resize(width * height * 4, 0);
     
     // Initialize RNG
     std::random_device rd;
     m_rng = std::mt19937(rd());
-    
-    // std::cout << "Created world with dimensions: " << width << "x" << height << std::endl;
-    // std::cout << "Chunk grid size: " << m_chunksX << "x" << m_chunksY << std::endl;
-    
-    // TEST: Add some blocks to each chunk for debugging the streaming system
-    for (int y = 0; y < m_chunksY; ++y) {
-        for (int x = 0; x < m_chunksX; ++x) {
-            // Get chunk
-            Chunk* chunk = getChunkAt(x, y);
-            if (!chunk) continue;
-            
-            // Add a distinctive pattern to each chunk
-            // Fill the entire chunk with different materials based on position
-            for (int localX = 0; localX < Chunk::WIDTH; localX++) {
-                for (int localY = 0; localY < Chunk::HEIGHT; localY++) {
-                    // Add a solid pattern with some materials
-                    MaterialType material;
-                    if ((x + y) % 3 == 0) material = MaterialType::Sand;
-                    else if ((x + y) % 3 == 1) material = MaterialType::Stone;
-                    else material = MaterialType::Gravel;
-                    
-                    // Set the material and mark as modified to force pixel update
-                    chunk->set(localX, localY, material);
-                }
-            }
-            
-            // Force pixel data update
-            chunk->updatePixelData();
-            
-            // Draw a border around each chunk
-            for (int i = 0; i < Chunk::WIDTH; i++) {
-                chunk->set(i, 0, MaterialType::Bedrock);
-                chunk->set(i, Chunk::HEIGHT-1, MaterialType::Bedrock);
-            }
-            for (int i = 0; i < Chunk::HEIGHT; i++) {
-                chunk->set(0, i, MaterialType::Bedrock);
-                chunk->set(Chunk::WIDTH-1, i, MaterialType::Bedrock);
+}
+
+void World::fillSpan(int x, int y, int length, MaterialType material) {
+    fillRect(x, y, length, 1, material);
+}
+
+void World::fillRect(int x, int y, int width, int height, MaterialType material) {
+    forEachChunkInRect(x, y, width, height, [material](Chunk::Editor& editor, int, int,
+                                                       int x0, int y0, int x1, int y1) {
+        for (int ly = y0; ly <= y1; ++ly) {
+            editor.fillSpan(x0, x1, ly, material);
+        }
+    });
+}
+
+void World::paintCircle(int centerX, int centerY, int radius, MaterialType material) {
+    if (radius < 0) {
+        return;
+    }
+    const int radiusSq = radius * radius;
+    forEachChunkInRect(centerX - radius, centerY - radius, 2 * radius + 1, 2 * radius + 1,
+                       [&](Chunk::Editor& editor, int originX, int originY,
+                           int x0, int y0, int x1, int y1) {
+        for (int ly = y0; ly <= y1; ++ly) {
+            // Widest half-span with dx*dx + dy*dy <= radius*radius on this row
+            int dy = originY + ly - centerY;
+            int half = static_cast<int>(std::sqrt(static_cast<double>(radiusSq - dy * dy)));
+            while (half * half > radiusSq - dy * dy) --half;
+            while ((half + 1) * (half + 1) <= radiusSq - dy * dy) ++half;
+            
+            int spanX0 = std::max(x0, centerX - half - originX);
+            int spanX1 = std::min(x1, centerX + half - originX);
+            editor.fillSpan(spanX0, spanX1, ly, material);
+        }
+    });
+}
+
+int RegionView::findView(int x, int y) const {
+    if (x < m_x || x >= m_x + m_width || y < m_y || y >= m_y + m_height) {
+        return -1;
+    }
+    int index = (y / Chunk::HEIGHT - m_firstChunkY) * m_chunksAcross + (x / Chunk::WIDTH - m_firstChunkX);
+    return m_views[index].cells ? index : -1;
+}
+
+RegionView World::view(int x, int y, int width, int height) const {
+    RegionView region;
+    region.m_x = std::max(0, x);
+    region.m_y = std::max(0, y);
+    int endX = std::min(m_width, x + width);      // Exclusive
+    int endY = std::min(m_height, y + height);
+    if (region.m_x >= endX || region.m_y >= endY) {
+        return region;
+    }
+    region.m_width = endX - region.m_x;
+    region.m_height = endY - region.m_y;
+    
+    region.m_firstChunkX = region.m_x / Chunk::WIDTH;
+    region.m_firstChunkY = region.m_y / Chunk::HEIGHT;
+    int lastChunkX = (endX - 1) / Chunk::WIDTH;
+    int lastChunkY = (endY - 1) / Chunk::HEIGHT;
+    region.m_chunksAcross = lastChunkX - region.m_firstChunkX + 1;
+    region.m_views.reserve(region.m_chunksAcross * (lastChunkY - region.m_firstChunkY + 1));
+    
+    for (int chunkY = region.m_firstChunkY; chunkY <= lastChunkY; ++chunkY) {
+        for (int chunkX = region.m_firstChunkX; chunkX <= lastChunkX; ++chunkX) {
+            // Overlap of the region and this chunk, in world coordinates
+            int x0 = std::max(region.m_x, chunkX * Chunk::WIDTH);
+            int y0 = std::max(region.m_y, chunkY * Chunk::HEIGHT);
+            int x1 = std::min(endX, (chunkX + 1) * Chunk::WIDTH);
+            int y1 = std::min(endY, (chunkY + 1) * Chunk::HEIGHT);
+            
+            const Chunk* chunk = getChunkAt(chunkX, chunkY);
+            if (chunk) {
+                region.m_views.push_back(chunk->view(x0 - chunkX * Chunk::WIDTH, y0 - chunkY * Chunk::HEIGHT,
+                                                     x1 - x0, y1 - y0));
+            } else {
+                region.m_views.push_back({nullptr, 0, x0, y0, x1 - x0, y1 - y0});
             }
         }
     }
+    return region;
 }
 
 MaterialType World::get(int x, int y) const {
@@ -1585,26 +1961,15 @@ MaterialType World::get(int x, int y) const {
     int chunkX, chunkY, localX, localY;
     worldToChunkCoords(x, y, chunkX, chunkY, localX, localY);
     
-    // Try to get from ChunkManager first (for streaming system)
-    ChunkCoord coord{chunkX, chunkY};
-    
-    // Need a non-const chunk to try loading from ChunkManager
-    // This const_cast is necessary because get() is const but needs to potentially load chunks
-    ChunkManager& manager = const_cast<ChunkManager&>(m_chunkManager);
-    Chunk* chunk = manager.getChunk(chunkX, chunkY, false); // Don't try to load, just check if available
-    
-    if (chunk) {
-        return chunk->get(localX, localY);
-    }
-    
-    // Fall back to the regular chunks
-    const Chunk* oldChunk = getChunkAt(chunkX, chunkY);
-    if (!oldChunk) {
+    // Chunks held in memory (loaded or cached) are read, never loaded from disk; a chunk
+    // that is not resident reads as empty
+    const Chunk* chunk = getChunkAt(chunkX, chunkY);
+    if (!chunk) {
         return MaterialType::Empty;
     }
     
     // Get material at local coordinates
-    return oldChunk->get(localX, localY);
+    return chunk->get(localX, localY);
 }
 
 void World::set(int x, int y, MaterialType material) {
@@ -1617,95 +1982,44 @@ void World::set(int x, int y, MaterialType material) {
     int chunkX, chunkY, localX, localY;
     worldToChunkCoords(x, y, chunkX, chunkY, localX, localY);
     
-    // Try to get from ChunkManager first (for streaming system)
-    Chunk* chunk = m_chunkManager.getChunk(chunkX, chunkY, true); // Load if needed
+    // Write into the streaming system's chunk, loading it if needed
+    Chunk* chunk = m_chunkManager.getChunk(chunkX, chunkY, true);
     if (chunk) {
-        // Set material at local coordinates in the ChunkManager's chunk
-        chunk->set(localX, localY, material);
-    }
-    
-    // Also set in the legacy system for now (for compatibility)
-    Chunk* oldChunk = getChunkAt(chunkX, chunkY);
-    if (oldChunk) {
         // Set material at local coordinates
-        oldChunk->set(localX, localY, material);
+        chunk->set(localX, localY, material);
     }
     
     // Track this processing chunk as dirty for optimized updates
-    int processingChunkX = x / PROCESSING_CHUNK_SIZE;
-    int processingChunkY = y / PROCESSING_CHUNK_SIZE;
-    m_dirtyChunks.push_back(std::make_pair(processingChunkX, processingChunkY));
+    markTileDirty(x, y);
     
-    // Update pixel data
+    // Update pixel data with the cell's shade from the material palette
     int idx = y * m_width + x;
     int pixelIdx = idx * 4;
     
-    const auto& props = MATERIAL_PROPERTIES[static_cast<std::size_t>(material)];
-    
-    // Calculate position-based hash for consistent texture patterns
-    int hash = ((x * 13) + (y * 7)) ^ ((x * 23) + (y * 17));
-    
-    // Initial variation values
-    int rVar = (hash % 21) - 10;  
-    int gVar = ((hash >> 4) % 21) - 10;
-    int bVar = ((hash >> 16) % 31) - 15;
-    
-    // Material-specific modifications
-    // Apply moderate variations to certain materials
-    switch (material) {
-        case MaterialType::Stone:
-            // Make stone more gray with moderate variation
-            rVar = gVar = bVar = (hash % 41) - 20;
-            break;
-        case MaterialType::Grass:
-            // Grass has moderate green variations
-            gVar = (hash % 31) - 15;  // More green variation
-            break;
-        case MaterialType::TopSoil:
-        case MaterialType::Dirt:
-            // Soil has brown variation
-            rVar = (hash % 25) - 12;
-            gVar = ((hash >> 4) % 21) - 10;
-            bVar = ((hash >> 8) % 17) - 8;
-            break;
-        case MaterialType::Gravel:
-            // Gravel has distinct texture
-            rVar = gVar = bVar = (hash % 37) - 18;
-            break;
-        case MaterialType::DenseRock:
-            // Dense rock has blue-gray variations
-            rVar = (hash % 25) - 12;
-            gVar = (hash % 25) - 12;
-            bVar = (hash % 33) - 16; // Slight blue tint variation
-            break;
-        default:
-            // Default variation is already set
-            break;
-    }
-    
-    // Apply color variation with proper clamping
-    int rInt = std::max(0, std::min(255, int(props.r) + rVar));
-    int gInt = std::max(0, std::min(255, int(props.g) + gVar));
-    int bInt = std::max(0, std::min(255, int(props.b) + bVar));
-    
-    m_pixelData[pixelIdx] = rInt;     // R
-    m_pixelData[pixelIdx+1] = gInt;   // G
-    m_pixelData[pixelIdx+2] = bInt;   // B
-    m_pixelData[pixelIdx+3] = props.transparency;  // A
+    const MaterialColor color = MaterialPalette::color(material, x, y);
+    m_pixelData[pixelIdx] = color.r;     // R
+    m_pixelData[pixelIdx+1] = color.g;   // G
+    m_pixelData[pixelIdx+2] = color.b;   // B
+    m_pixelData[pixelIdx+3] = color.a;   // A
 }
 
-bool Chunk::isNotIsolatedLiquid(const std::vector<MaterialType>& grid, int x, int y) {
+bool Chunk::isNotIsolatedLiquid(int x, int y) const {
     // Skip bounds check for performance in internal use
-    int idx = y * WIDTH + x;
-    if (idx < 0 || idx >= static_cast<int>(grid.size())) {
+    int idx = cellIndex(x, y);
+    if (idx < 0 || idx >= static_cast<int>(m_cells.size())) {
+        return false;
+    }
+    
+    // Cells that already moved this update are not re-examined
+    if (m_cells[idx].moveStamp == m_fallStamp || m_cells[idx].moveStamp == m_spreadStamp) {
         return false;
     }
     
-    MaterialType material = grid[idx];
-    const auto& props = MATERIAL_PROPERTIES[static_cast<std::size_t>(material)];
+    MaterialType material = m_cells[idx].material;
+    const MaterialTables& materials = MaterialRegistry::tables();
     
     // If not a liquid, it's not an isolated liquid
-    if (!props.isLiquid) {
+    if (!materials.is(material, MATERIAL_LIQUID)) {
         return false;
     }
     
@@ -1725,12 +2039,12 @@ bool Chunk::isNotIsolatedLiquid(const std::vector<MaterialType>& grid, int x, in
                 continue;
             }
             
-            int neighborIdx = ny * WIDTH + nx;
-            if (neighborIdx < 0 || neighborIdx >= static_cast<int>(grid.size())) {
+            int neighborIdx = cellIndex(nx, ny);
+            if (neighborIdx < 0 || neighborIdx >= static_cast<int>(m_cells.size())) {
                 continue;
             }
             
-            MaterialType neighbor = grid[neighborIdx];
+            MaterialType neighbor = m_cells[neighborIdx].material;
             
             // If neighbor is empty, the liquid can flow there
             if (neighbor == MaterialType::Empty) {
@@ -1738,8 +2052,7 @@ bool Chunk::isNotIsolatedLiquid(const std::vector<MaterialType>& grid, int x, in
             }
             
             // If neighbor is another liquid, they can interact
-            const auto& neighborProps = MATERIAL_PROPERTIES[static_cast<std::size_t>(neighbor)];
-            if (neighborProps.isLiquid) {
+            if (materials.is(neighbor, MATERIAL_LIQUID)) {
                 return true;
             }
         }
@@ -1749,352 +2062,163 @@ bool Chunk::isNotIsolatedLiquid(const std::vector<MaterialType>& grid, int x, in
     return false;
 }
 
+void World::setTickRate(double ticksPerSecond) {
+    if (ticksPerSecond > 0.0) {
+        m_tickRate = ticksPerSecond;
+    }
+}
+
+int World::advance(double dt) {
+    if (dt > 0.0) {
+        m_tickAccumulator += dt;
+    }
+    
+    const double tickLength = 1.0 / m_tickRate;
+    int ticks = 0;
+    while (m_tickAccumulator >= tickLength && ticks < m_maxTicksPerAdvance) {
+        update();
+        m_tickAccumulator -= tickLength;
+        ++ticks;
+    }
+    
+    // Out of catch-up budget: drop the backlog rather than carry it into the next frame,
+    // where it would only make that frame slower too
+    if (m_tickAccumulator >= tickLength) {
+        m_tickAccumulator = std::fmod(m_tickAccumulator, tickLength);
+    }
+    
+    return ticks;
+}
+
 void World::update() {
-    // Performance optimization - skip updates every other frame
-    static bool skipFrame = false;
-    skipFrame = !skipFrame;
-    if (skipFrame) {
-        return; // Skip this frame completely for performance
-    }
-    
-    // Process dirty chunks from player interactions first, but directly mark the chunks as dirty
-    if (!m_dirtyChunks.empty()) {
-        // Remove duplicates to avoid processing the same chunk multiple times
-        std::sort(m_dirtyChunks.begin(), m_dirtyChunks.end());
-        auto last = std::unique(m_dirtyChunks.begin(), m_dirtyChunks.end());
-        std::vector<std::pair<int, int>> uniqueDirtyChunks(m_dirtyChunks.begin(), last);
-        m_dirtyChunks.clear();
-        
-        // Process each dirty processing chunk by marking actual chunks dirty
-        for (const auto& processingChunk : uniqueDirtyChunks) {
-            int startX = processingChunk.first * PROCESSING_CHUNK_SIZE;
-            int startY = processingChunk.second * PROCESSING_CHUNK_SIZE;
-            
-            // Find the storage chunk that contains this processing chunk
-            int chunkX = startX / Chunk::WIDTH;
-            int chunkY = startY / Chunk::HEIGHT;
-            
-            // Mark the actual chunk as dirty so it will be updated
-            Chunk* chunk = m_chunkManager.getChunk(chunkX, chunkY, false);
+    ++m_tick;
+    
+    // Wake the processing chunks written by player interactions since the last update: they
+    // are the storage chunks' tiles
+    for (std::size_t word = 0; word < m_dirtyTiles.size(); ++word) {
+        for (uint64_t bits = m_dirtyTiles[word]; bits != 0; bits &= bits - 1) {
+            int tile = static_cast<int>(word) * 64 + lowestBit(bits);
+            int startX = (tile % m_tilesX) * PROCESSING_CHUNK_SIZE;
+            int startY = (tile / m_tilesX) * PROCESSING_CHUNK_SIZE;
+            
+            Chunk* chunk = m_chunkManager.getChunk(startX / Chunk::WIDTH, startY / Chunk::HEIGHT, false);
             if (chunk) {
-                chunk->setDirty(true);
+                chunk->wakeTile((startX % Chunk::WIDTH) / Chunk::TILE_SIZE,
+                                (startY % Chunk::HEIGHT) / Chunk::TILE_SIZE);
                 chunk->setShouldUpdateNextFrame(true);
             }
         }
+        m_dirtyTiles[word] = 0;
     }
     
-    // Handle special edge-case cleanup less frequently
-    static int cleanupCounter = 0;
-    cleanupCounter++;
-    
-    // Less frequent cleanup (every 60 frames now)
-    if (cleanupCounter >= 60) {
-        cleanupCounter = 0;
-        // Only clean up active chunks to avoid wasting resources
-        const auto& activeChunks = m_chunkManager.getActiveChunks();
-        for (const auto& coord : activeChunks) {
-            Chunk* chunk = m_chunkManager.getChunk(coord.x, coord.y, false);
-            if (chunk && chunk->getInactivityCounter() > 50) {
-                chunk->setDirty(true);
-            }
-        }
-    }
-    
-    // Get active chunks just once to avoid repeated calls
-    const auto& activeChunks = m_chunkManager.getActiveChunks();
-    
-    // Process more chunks for better world update
-    const int MAX_CHUNKS_TO_PROCESS = 12;
-    int chunksProcessed = 0;
-    
-    // Process most important chunks first - those with pending updates
-    for (const auto& coord : activeChunks) {
-        Chunk* chunk = m_chunkManager.getChunk(coord.x, coord.y, false);
-        if (!chunk) continue;
-        
-        // Only process chunks that need updates
-        if (chunk->shouldUpdateNextFrame()) {
-            chunk->setDirty(true);
-            chunk->setShouldUpdateNextFrame(false);
-            
-            // Get neighboring chunks
-            ChunkCoord belowCoord = {coord.x, coord.y + 1};
-            ChunkCoord leftCoord = {coord.x - 1, coord.y};
-            ChunkCoord rightCoord = {coord.x + 1, coord.y};
-            
-            Chunk* chunkBelow = m_chunkManager.getChunk(belowCoord.x, belowCoord.y, false);
-            Chunk* chunkLeft = m_chunkManager.getChunk(leftCoord.x, leftCoord.y, false);
-            Chunk* chunkRight = m_chunkManager.getChunk(rightCoord.x, rightCoord.y, false);
-            
-            // Update this chunk
-            chunk->update(chunkBelow, chunkLeft, chunkRight);
-            chunksProcessed++;
-            
-            if (chunksProcessed >= MAX_CHUNKS_TO_PROCESS) {
-                return; // Early exit after processing max chunks
-            }
-        }
-    }
-    
-    // If we still have capacity, process a few more chunks
-    for (const auto& coord : activeChunks) {
-        if (chunksProcessed >= MAX_CHUNKS_TO_PROCESS) break;
-        
-        Chunk* chunk = m_chunkManager.getChunk(coord.x, coord.y, false);
-        if (!chunk || !chunk->isDirty()) continue;
-        
-        // Get neighboring chunks
-        ChunkCoord belowCoord = {coord.x, coord.y + 1};
-        ChunkCoord leftCoord = {coord.x - 1, coord.y};
-        ChunkCoord rightCoord = {coord.x + 1, coord.y};
-        
-        Chunk* chunkBelow = m_chunkManager.getChunk(belowCoord.x, belowCoord.y, false);
-        Chunk* chunkLeft = m_chunkManager.getChunk(leftCoord.x, leftCoord.y, false);
-        Chunk* chunkRight = m_chunkManager.getChunk(rightCoord.x, rightCoord.y, false);
-        
-        // Update this chunk
-        chunk->update(chunkBelow, chunkLeft, chunkRight);
-        chunksProcessed++;
-    }
-    
-    // Special check for powders and liquids at chunk boundaries to prevent stuck particles
-    // Only process active chunks to avoid wasting CPU on unseen chunks
-    for (const auto& coord : activeChunks) {
-        Chunk* chunk = m_chunkManager.getChunk(coord.x, coord.y, false);
-        if (chunk && chunk->isDirty()) {
-            int i = coord.y * m_chunksX + coord.x; // Calculate index in m_chunks
-            int y = i / m_chunksX;
-            int x = i % m_chunksX;
-            
-            // Only check the bottom row if there's a chunk below
-            if (y < m_chunksY - 1) {
-                Chunk* chunkBelow = getChunkAt(x, y + 1);
-                if (chunkBelow) {
-                    // Check every cell in the bottom row of this chunk
-                    for (int localX = 0; localX < Chunk::WIDTH; localX++) {
-                        MaterialType material = chunk->get(localX, Chunk::HEIGHT - 1);
-                        if (material != MaterialType::Empty) {
-                            const auto& props = MATERIAL_PROPERTIES[static_cast<std::size_t>(material)];
-                            
-                            // If it's a powder or liquid, always check for falling
-                            if (props.isPowder || props.isLiquid) {
-                                // Special case: For materials at chunk boundaries, actively try to move them
-                                // across the boundary rather than just marking for a later update
-                                MaterialType belowMaterial = chunkBelow->get(localX, 0);
-                                
-                                // Check if material can displace what's below
-                                bool canMove = false;
-                                
-                                if (belowMaterial == MaterialType::Empty) {
-                                    canMove = true;
-                                } else if (props.isLiquid) {
-                                    // For liquids, check if they can displace the material below
-                                    const auto& belowProps = MATERIAL_PROPERTIES[static_cast<std::size_t>(belowMaterial)];
-                                    
-                                    // Handle density-based displacements between different liquids
-                                    if (belowProps.isLiquid) {
-                                        if ((material == MaterialType::Lava && belowMaterial == MaterialType::Water) ||
-                                            (material == MaterialType::Water && belowMaterial == MaterialType::Oil) ||
-                                            (material == MaterialType::Lava && belowMaterial == MaterialType::Oil)) {
-                                            canMove = true;
-                                        }
-                                    }
-                                }
-                                
-                                if (canMove) {
-                                    // Directly move material down, displacing what's below if needed
-                                    MaterialType originalBelowMaterial = belowMaterial;
-                                    chunkBelow->set(localX, 0, material);
-                                    chunk->set(localX, Chunk::HEIGHT - 1, MaterialType::Empty);
-                                    
-                                    // Set the element as free-falling in the chunk below
-                                    chunkBelow->setFreeFalling(localX, true);
-                                } else {
-                                    // Try to move diagonally if directly below is blocked
-                                    bool moved = false;
-                                    
-                                    // Randomly choose which side to try first
-                                    bool tryLeftFirst = (rand() % 2 == 0);
-                                    
-                                    if (tryLeftFirst) {
-                                        // Try down-left
-                                        if (localX > 0) {
-                                            MaterialType downLeftMaterial = chunkBelow->get(localX - 1, 0);
-                                            if (downLeftMaterial == MaterialType::Empty) {
-                                                chunkBelow->set(localX - 1, 0, material);
-                                                chunk->set(localX, Chunk::HEIGHT - 1, MaterialType::Empty);
-                                                chunkBelow->setFreeFalling(localX-1,true);
-                                                moved = true;
-                                            }
-                                        }
-                                        
-                                        // Try down-right if didn't move down-left
-                                        if (!moved && localX < Chunk::WIDTH - 1) {
-                                            MaterialType downRightMaterial = chunkBelow->get(localX + 1, 0);
-                                            if (downRightMaterial == MaterialType::Empty) {
-                                                chunkBelow->set(localX + 1, 0, material);
-                                                chunk->set(localX, Chunk::HEIGHT - 1, MaterialType::Empty);
-                                                chunkBelow->setFreeFalling(localX+1,true);
-                                                moved = true;
-                                            }
-                                        }
-                                    } else {
-                                        // Try down-right first
-                                        if (localX < Chunk::WIDTH - 1) {
-                                            MaterialType downRightMaterial = chunkBelow->get(localX + 1, 0);
-                                            if (downRightMaterial == MaterialType::Empty) {
-                                                chunkBelow->set(localX + 1, 0, material);
-                                                chunk->set(localX, Chunk::HEIGHT - 1, MaterialType::Empty);
-                                                chunkBelow->setFreeFalling(localX+1,true);
-                                                moved = true;
-                                            }
-                                        }
-                                        
-                                        // Try down-left if didn't move down-right
-                                        if (!moved && localX > 0) {
-                                            MaterialType downLeftMaterial = chunkBelow->get(localX - 1, 0);
-                                            if (downLeftMaterial == MaterialType::Empty) {
-                                                chunkBelow->set(localX - 1, 0, material);
-                                                chunk->set(localX, Chunk::HEIGHT - 1, MaterialType::Empty);
-                                                chunkBelow->setFreeFalling(localX-1,true);
-                                                moved = true;
-                                            }
-                                        }
-                                    }
-                                    
-                                    // For liquids at chunk boundaries, also try horizontal spread
-                                    // if vertical movement isn't possible
-                                    if (!moved && props.isLiquid) {
-                                        // Try to move left
-                                        if (localX > 0) {
-                                            MaterialType leftMaterial = chunk->get(localX - 1, Chunk::HEIGHT - 1);
-                                            if (leftMaterial == MaterialType::Empty) {
-                                                chunk->set(localX - 1, Chunk::HEIGHT - 1, material);
-                                                chunk->set(localX, Chunk::HEIGHT - 1, MaterialType::Empty);
-                                                moved = true;
-                                            }
-                                        }
-                                        
-                                        // Try to move right
-                                        if (!moved && localX < Chunk::WIDTH - 1) {
-                                            MaterialType rightMaterial = chunk->get(localX + 1, Chunk::HEIGHT - 1);
-                                            if (rightMaterial == MaterialType::Empty) {
-                                                chunk->set(localX + 1, Chunk::HEIGHT - 1, material);
-                                                chunk->set(localX, Chunk::HEIGHT - 1, MaterialType::Empty);
-                                                moved = true;
-                                            }
-                                        }
-                                    }
-                                }
-                                
-                                // Always mark both chunks for update next frame
-                                chunk->setShouldUpdateNextFrame(true);
-                                chunkBelow->setShouldUpdateNextFrame(true);
-                            }
-                        }
-                    }
-                }
-            }
-            
-            // Check for liquids at horizontal chunk boundaries that might get stuck
-            // Left edge
-            if (x > 0) {
-                Chunk* chunkLeft = getChunkAt(x - 1, y);
-                if (chunkLeft) {
-                    // Check leftmost column of this chunk and rightmost of left chunk
-                    for (int localY = 0; localY < Chunk::HEIGHT; localY++) {
-                        MaterialType material = chunk->get(0, localY);
-                        if (material != MaterialType::Empty) {
-                            const auto& props = MATERIAL_PROPERTIES[static_cast<std::size_t>(material)];
-                            
-                            // Only process liquids for horizontal edge cases
-                            if (props.isLiquid) {
-                                MaterialType leftMaterial = chunkLeft->get(Chunk::WIDTH - 1, localY);
-                                if (leftMaterial == MaterialType::Empty) {
-                                    // Liquid can flow left across chunk boundary
-                                    // Always move all material to maintain volume
-                                    chunkLeft->set(Chunk::WIDTH - 1, localY, material);
-                                    chunk->set(0, localY, MaterialType::Empty);
-                                    
-                                    // Mark chunks for next frame update
-                                    chunk->setShouldUpdateNextFrame(true);
-                                    chunkLeft->setShouldUpdateNextFrame(true);
-                                }
-                            }
-                        }
-                    }
-                }
-            }
-            
-            // Right edge
-            if (x < m_chunksX - 1) {
-                Chunk* chunkRight = getChunkAt(x + 1, y);
-                if (chunkRight) {
-                    // Check rightmost column of this chunk and leftmost of right chunk
-                    for (int localY = 0; localY < Chunk::HEIGHT; localY++) {
-                        MaterialType material = chunk->get(Chunk::WIDTH - 1, localY);
-                        if (material != MaterialType::Empty) {
-                            const auto& props = MATERIAL_PROPERTIES[static_cast<std::size_t>(material)];
-                            
-                            // Only process liquids for horizontal edge cases
-                            if (props.isLiquid) {
-                                MaterialType rightMaterial = chunkRight->get(0, localY);
-                                if (rightMaterial == MaterialType::Empty) {
-                                    // Liquid can flow right across chunk boundary
-                                    // Always move all material to maintain volume
-                                    chunkRight->set(0, localY, material);
-                                    chunk->set(Chunk::WIDTH - 1, localY, MaterialType::Empty);
-                                    
-                                    // Mark chunks for next frame update
-                                    chunk->setShouldUpdateNextFrame(true);
-                                    chunkRight->setShouldUpdateNextFrame(true);
-                                }
-                            }
-                        }
-                    }
-                }
-            }
+    // Gather the dirty active chunks - and, on every LOD_TICK_INTERVAL-th tick, the dirty
+    // chunks of the reduced-rate ring around them - into a queue ordered by priority. Pending flags are
+    // consumed only for the chunks picked, before any chunk runs, so flags raised by this
+    // tick's updates - and the chunks left waiting - carry over to the next tick.
+    struct QueuedChunk {
+        int priority;
+        ChunkCoord coord;
+        Chunk* chunk;
+        
+        bool operator<(const QueuedChunk& other) const {
+            if (priority != other.priority) return priority < other.priority;
+            // Equal priorities: fixed order, so the picks do not depend on the active list
+            return coord.y != other.coord.y ? coord.y > other.coord.y : coord.x > other.coord.x;
+        }
+    };
+    std::priority_queue<QueuedChunk> queue;
+    auto enqueue = [&](const ChunkCoord& coord) {
+        Chunk* chunk = m_chunkManager.getResidentChunk(coord.x, coord.y);
+        if (!chunk) return;
+        
+        ChunkSchedule& schedule = m_chunkSchedule[coord];
+        if (!chunk->shouldUpdateNextFrame() && !chunk->isDirty()) {
+            schedule.waitedTicks = 0;
+            return;
+        }
+        queue.push({chunkPriority(coord, schedule), coord, chunk});
+    };
+    for (const auto& coord : m_chunkManager.getActiveChunks()) {
+        enqueue(coord);
+    }
+    if (m_tick % LOD_TICK_INTERVAL == 0) {
+        for (const auto& coord : m_chunkManager.getLodChunks()) {
+            enqueue(coord);
         }
     }
     
-    // Update all dirty chunks and propagate activity to neighbors
-    for (int i = 0; i < (int)m_chunks.size(); ++i) {
-        auto& chunk = m_chunks[i];
-        if (chunk && chunk->isDirty()) {
-            int y = i / m_chunksX;
-            int x = i % m_chunksX;
-            
-            // Mark neighboring chunks for update next frame to ensure proper physics across chunk boundaries
-            for (int dy = -1; dy <= 1; ++dy) {
-                for (int dx = -1; dx <= 1; ++dx) {
-                    // Skip self, already marked
-                    if (dx == 0 && dy == 0) continue;
-                    
-                    int nx = x + dx;
-                    int ny = y + dy;
-                    
-                    if (nx >= 0 && nx < m_chunksX && ny >= 0 && ny < m_chunksY) {
-                        Chunk* neighbor = getChunkAt(nx, ny);
-                        if (neighbor) {
-                            neighbor->setShouldUpdateNextFrame(true);
-                        }
-                    }
-                }
-            }
-            
-            // Now update the chunk with references to its neighbors
-            Chunk* chunkBelow = (y < m_chunksY - 1) ? getChunkAt(x, y + 1) : nullptr;
-            Chunk* chunkLeft = (x > 0) ? getChunkAt(x - 1, y) : nullptr;
-            Chunk* chunkRight = (x < m_chunksX - 1) ? getChunkAt(x + 1, y) : nullptr;
-            
-            chunk->update(chunkBelow, chunkLeft, chunkRight);
+    // Take chunks until their expected cost fills the budget. The budget is counted as if the
+    // chunks ran one after another: checkerboard phases rarely keep every thread busy, so
+    // counting on the threads would overshoot. The first chunk always runs, so even a budget
+    // below one chunk's cost keeps the world moving.
+    const float budgetMicros = static_cast<float>(m_simulationBudgetMicros);
+    float plannedMicros = 0.0f;
+    std::vector<ChunkSchedule*> scheduled;
+    while (!queue.empty()) {
+        const QueuedChunk& next = queue.top();
+        ChunkSchedule& schedule = m_chunkSchedule[next.coord];
+        if (m_simulationBudgetMicros > 0 && !scheduled.empty() &&
+            plannedMicros + schedule.updateMicros > budgetMicros) {
+            break;
         }
+        plannedMicros += schedule.updateMicros;
+        schedule.waitedTicks = 0;
+        scheduled.push_back(&schedule);
+        
+        next.chunk->setDirty(true);
+        next.chunk->setShouldUpdateNextFrame(false);
+        m_scheduler.addChunk(next.coord.x, next.coord.y, next.chunk,
+                             getChunkNeighbors(next.coord.x, next.coord.y), &schedule.lastMicros);
+        queue.pop();
+    }
+    
+    // Whatever missed the budget ages and is tried again next tick
+    for (; !queue.empty(); queue.pop()) {
+        ++m_chunkSchedule[queue.top().coord].waitedTicks;
+    }
+    
+    // Update the picked chunks in parallel, one checkerboard phase at a time. Cells crossing
+    // a chunk edge travel through the chunks' halos, so no boundary fix-up pass follows.
+    m_scheduler.run();
+    
+    // Blend the measured costs into the estimates the next tick plans with
+    for (ChunkSchedule* schedule : scheduled) {
+        schedule->updateMicros = 0.5f * (schedule->updateMicros + schedule->lastMicros);
     }
     
     // Update the combined pixel data from all chunks
     updateWorldPixelData();
 }
 
+int World::chunkPriority(const ChunkCoord& coord, const ChunkSchedule& schedule) const {
+    // Chebyshev distance in chunks from the player's chunk
+    int distance = std::max(std::abs(coord.x - m_playerX / Chunk::WIDTH),
+                            std::abs(coord.y - m_playerY / Chunk::HEIGHT));
+    
+    bool visible = m_viewWidth > 0 && m_viewHeight > 0 &&
+                   m_chunkManager.isChunkVisible(coord.x, coord.y, m_viewX, m_viewY,
+                                                 m_viewWidth, m_viewHeight);
+    
+    // Every tick spent waiting outweighs a chunk of distance, so no chunk waits forever
+    return schedule.waitedTicks + (visible ? VISIBLE_PRIORITY : 0) - distance;
+}
+
+void World::dropUnscheduledChunks() {
+    // Only active and LOD-ring chunks are ever enqueued; one that comes back later starts
+    // over with a fresh cost estimate
+    const std::vector<ChunkCoord>& active = m_chunkManager.getActiveChunks();
+    const std::vector<ChunkCoord>& lod = m_chunkManager.getLodChunks();
+    for (auto it = m_chunkSchedule.begin(); it != m_chunkSchedule.end();) {
+        const ChunkCoord& coord = it->first;
+        if (std::find(active.begin(), active.end(), coord) == active.end() &&
+            std::find(lod.begin(), lod.end(), coord) == lod.end()) {
+            it = m_chunkSchedule.erase(it);
+        } else {
+            ++it;
+        }
+    }
+}
+
 void World::update(int startX, int startY, int endX, int endY) {
     // Bounds check
     startX = std::max(0, std::min(m_width - 1, startX));
@@ -2119,7 +2243,7 @@ void World::update(int startX, int startY, int endX, int endY) {
         for (int x = startChunkX; x < endChunkX; ++x) {
             Chunk* chunk = getChunkAt(x, y);
             if (chunk) {
-                chunk->setDirty(true);
+                chunk->markAllDirty();
                 
                 // Mark neighboring chunks as dirty too for proper physics
                 for (int dy = -1; dy <= 1; ++dy) {
@@ -2133,7 +2257,7 @@ void World::update(int startX, int startY, int endX, int endY) {
                         if (nx >= 0 && nx < m_chunksX && ny >= 0 && ny < m_chunksY) {
                             Chunk* neighbor = getChunkAt(nx, ny);
                             if (neighbor) {
-                                neighbor->setDirty(true);
+                                neighbor->markAllDirty();
                             }
                         }
                     }
@@ -2152,14 +2276,11 @@ void World::update(int startX, int startY, int endX, int endY) {
         for (int x = paddedStartChunkX; x < paddedEndChunkX; ++x) {
             Chunk* chunk = getChunkAt(x, y);
             if (chunk && chunk->isDirty()) {
-                Chunk* chunkBelow  = (y < m_chunksY - 1) ? getChunkAt(x, y + 1) : nullptr;
-                Chunk* chunkLeft   = (x > 0)             ? getChunkAt(x - 1, y) : nullptr;
-                Chunk* chunkRight  = (x < m_chunksX - 1) ? getChunkAt(x + 1, y) : nullptr;
-                
-                chunk->update(chunkBelow, chunkLeft, chunkRight);
+                m_scheduler.addChunk(x, y, chunk, getChunkNeighbors(x, y));
             }
         }
     }
+    m_scheduler.run();
     
     // Update pixel data for the entire world
     // This is simpler than trying to update just a subset of the pixel data
@@ -2170,10 +2291,12 @@ void World::levelLiquids() {
     // This function performs extra simulation steps to ensure liquids properly settle
     // It's useful after initial world generation or after a large change to the world
     
-    // Mark all chunks as dirty to ensure everything gets processed
-    for (int i = 0; i < (int)m_chunks.size(); ++i) {
-        if (m_chunks[i]) {
-            m_chunks[i]->setDirty(true);
+    // Mark all resident chunks as dirty to ensure everything gets processed
+    for (int y = 0; y < m_chunksY; ++y) {
+        for (int x = 0; x < m_chunksX; ++x) {
+            if (Chunk* chunk = getChunkAt(x, y)) {
+                chunk->markAllDirty();
+            }
         }
     }
     
@@ -2210,7 +2333,7 @@ void World::levelLiquids(int startX, int startY, int endX, int endY) {
         for (int x = startChunkX; x < endChunkX; ++x) {
             Chunk* chunk = getChunkAt(x, y);
             if (chunk) {
-                chunk->setDirty(true);
+                chunk->markAllDirty();
             }
         }
     }
@@ -2297,6 +2420,11 @@ void World::generate(unsigned int seed) {
     // Seed the RNG
     m_rng.seed(seed);
     
+    // The simulation's random draws follow the same seed
+    m_seed = seed;
+    m_tick = 0;
+    m_chunkManager.setRandomSeed(seed);
+    
     // std::cout << "Generating world with seed: " << seed << std::endl;
     
     // World generation constants
@@ -2313,11 +2441,7 @@ void World::generate(unsigned int seed) {
     const int transitionWidth = WORLD_WIDTH / 10;
     
     // Clear the world first with empty space
-    for (int x = 0; x < WORLD_WIDTH; ++x) {
-        for (int y = 0; y < WORLD_HEIGHT; ++y) {
-            set(x, y, MaterialType::Empty);
-        }
-    }
+    fillRect(0, 0, WORLD_WIDTH, WORLD_HEIGHT, MaterialType::Empty);
     
     // Flag to track for step-by-step rendering of cave generation
     bool renderStepByStep = true;
@@ -2979,17 +3103,26 @@ Chunk* World::getChunkAt(int x, int y) {
         return nullptr;
     }
     
-    int idx = y * m_chunksX + x;
-    return m_chunks[idx].get();
+    // Loaded or cached chunks, the same ones the simulation and writes see; lookups never
+    // trigger disk I/O
+    return m_chunkManager.getResidentChunk(x, y);
 }
 
 const Chunk* World::getChunkAt(int x, int y) const {
-    if (x < 0 || x >= m_chunksX || y < 0 || y >= m_chunksY) {
-        return nullptr;
+    // ChunkManager::getResidentChunk never loads anything; it only lacks a const overload
+    return const_cast<World*>(this)->getChunkAt(x, y);
+}
+
+ChunkNeighbors World::getChunkNeighbors(int chunkX, int chunkY) {
+    ChunkNeighbors neighbors;
+    for (int dy = -1; dy <= 1; ++dy) {
+        for (int dx = -1; dx <= 1; ++dx) {
+            if (dx != 0 || dy != 0) {
+                neighbors.at(dx, dy) = m_chunkManager.getResidentChunk(chunkX + dx, chunkY + dy);
+            }
+        }
     }
-    
-    int idx = y * m_chunksX + x;
-    return m_chunks[idx].get();
+    return neighbors;
 }
 
 void World::worldToChunkCoords(int worldX, int worldY, int& chunkX, int& chunkY, int& localX, int& localY) const {
@@ -3373,38 +3506,37 @@ void World::placeOreCluster(int centerX, int centerY, MaterialType oreType, int
 }
 
 void World::updateWorldPixelData() {
-    // Update combined pixel data from all chunks
+    m_pixelChanges.clear();
+    std::vector<DirtyRect> spans;
     for (int y = 0; y < m_chunksY; ++y) {
         for (int x = 0; x < m_chunksX; ++x) {
             Chunk* chunk = getChunkAt(x, y);
             if (!chunk) continue;
             
-            // Copy chunk's pixel data to the world's pixel data
-            int chunkBaseX = x * Chunk::WIDTH;
-            int chunkBaseY = y * Chunk::HEIGHT;
+            // Chunks that were edited or loaded without updating still have rows to recolour
+            chunk->updateChangedPixels();
             
+            // Copy the chunk's changed spans to the world's pixel data, a row at a time
+            const int chunkBaseX = x * Chunk::WIDTH;
+            const int chunkBaseY = y * Chunk::HEIGHT;
             const uint8_t* chunkPixelData = chunk->getPixelData();
-            
-            for (int cy = 0; cy < Chunk::HEIGHT; ++cy) {
-                int worldY = chunkBaseY + cy;
-                if (worldY >= m_height) continue;
+            spans.clear();
+            chunk->takePixelChanges(spans);
+            for (const DirtyRect& span : spans) {
+                DirtyRect changed;
+                changed.minX = chunkBaseX + span.minX;
+                changed.minY = chunkBaseY + span.minY;
+                changed.maxX = std::min(chunkBaseX + span.maxX, m_width - 1);
+                changed.maxY = std::min(chunkBaseY + span.maxY, m_height - 1);
+                if (changed.isEmpty()) continue;
                 
-                for (int cx = 0; cx < Chunk::WIDTH; ++cx) {
-                    int worldX = chunkBaseX + cx;
-                    if (worldX >= m_width) continue;
-                    
-                    int chunkIdx = (cy * Chunk::WIDTH + cx) * 4;
-                    int worldIdx = (worldY * m_width + worldX) * 4;
-
-                    // Just check worldIdx; chunkIdx is guaranteed good by the for loops
-                    if (worldIdx + 3 < (int)m_pixelData.size()) {
-                        m_pixelData[worldIdx + 0] = chunkPixelData[chunkIdx + 0];
-                        m_pixelData[worldIdx + 1] = chunkPixelData[chunkIdx + 1];
-                        m_pixelData[worldIdx + 2] = chunkPixelData[chunkIdx + 2];
-                        m_pixelData[worldIdx + 3] = chunkPixelData[chunkIdx + 3];
-                    }
-
+                const int width = changed.maxX - changed.minX + 1;
+                for (int worldY = changed.minY; worldY <= changed.maxY; ++worldY) {
+                    const int cy = worldY - chunkBaseY;
+                    std::memcpy(&m_pixelData[(worldY * m_width + changed.minX) * 4],
+                                chunkPixelData + (cy * Chunk::WIDTH + span.minX) * 4, width * 4);
                 }
+                m_pixelChanges.push_back(changed);
             }
         }
     }
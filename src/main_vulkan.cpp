@@ -4,7 +4,8 @@
 #include <vulkan/vulkan.h>
 #include <SDL2/SDL_vulkan.h>
 #include <algorithm>
-#include <map>
+#include <cstdlib>
+#include <fstream>
 #include <string>
 
 #include "../include/Materials.h"
@@ -23,6 +24,7 @@ const int WORLD_WIDTH   = TEST_MODE ? 800 : 6000;  // Much smaller for test mode
 const int WORLD_HEIGHT  = TEST_MODE ? 600 : 6000;  // Much deeper world for exploration with chunk streaming
 const int TARGET_FPS    = 60;  // Higher FPS for smoother simulation
 const int FRAME_DELAY   = 1000 / TARGET_FPS;
+const int SIM_BUDGET_US = 8000;  // Simulation time per tick; chunks over budget wait a tick
 
 // Camera parameters
 int cameraX = 0;         // Camera position X
@@ -39,7 +41,30 @@ int prevMouseX = 0, prevMouseY = 0;
 // Character mode parameters
 bool playerMode = false;  // Toggle between camera mode and player mode
 
-int main() {
+int main(int argc, char* argv[]) {
+    // Command line options
+    int simulationThreads = 0; // 0 = one simulation thread per hardware thread
+    for (int i = 1; i < argc; ++i) {
+        std::string arg = argv[i];
+        if (arg == "--threads" && i + 1 < argc) {
+            simulationThreads = std::atoi(argv[++i]);
+        } else if (arg == "--powder-kernel" && i + 1 < argc) {
+            // A/B switch between the per-cell and the 64-cells-per-word powder pass
+            std::string kernel = argv[++i];
+            PixelPhys::Chunk::setPowderKernel(kernel == "scalar" ? PixelPhys::Chunk::PowderKernel::Scalar
+                                                                 : PixelPhys::Chunk::PowderKernel::Bitboard);
+        } else if (arg == "--update-mode" && i + 1 < argc) {
+            // A/B switch between separate sweeps per step and the single fused sweep
+            std::string mode = argv[++i];
+            PixelPhys::Chunk::setUpdateMode(mode == "multipass" ? PixelPhys::Chunk::UpdateMode::MultiPass
+                                                                : PixelPhys::Chunk::UpdateMode::Fused);
+        } else {
+            std::cerr << "Unknown argument: " << arg
+                      << " (usage: PixelPhys2D [--threads N] [--powder-kernel scalar|bitboard]"
+                      << " [--update-mode multipass|fused])" << std::endl;
+        }
+    }
+    
     // Initialize SDL with video support
     if (SDL_Init(SDL_INIT_VIDEO) < 0) {
         std::cerr << "SDL could not initialize! SDL_Error: " 
@@ -69,19 +94,27 @@ int main() {
     // std::cout << "Drawable size (after going fullscreen): "
     //          << actualWidth << "x" << actualHeight << std::endl;
     
+    // Tune materials from materials.def when there is one (project root or build directory);
+    // without it the built-in materials are used
+    if (std::ifstream("materials.def").good()) {
+        PixelPhys::World::loadMaterials("materials.def");
+    } else if (std::ifstream("../materials.def").good()) {
+        PixelPhys::World::loadMaterials("../materials.def");
+    }
+    
     // Create the world and generate terrain or simple test environment
     PixelPhys::World world(WORLD_WIDTH, WORLD_HEIGHT);
+    world.setSimulationBudget(SIM_BUDGET_US);
+    if (simulationThreads > 0) {
+        world.setSimulationThreads(simulationThreads);
+    }
     
     if (TEST_MODE) {
         // Create a simple test environment instead of a full world
         // std::cout << "Creating test environment for physics testing..." << std::endl;
         
         // Create a flat bottom platform across the world
-        for (int x = 0; x < WORLD_WIDTH; x++) {
-            for (int y = WORLD_HEIGHT - 50; y < WORLD_HEIGHT; y++) {
-                world.set(x, y, PixelPhys::MaterialType::Stone);
-            }
-        }
+        world.fillRect(0, WORLD_HEIGHT - 50, WORLD_WIDTH, 50, PixelPhys::MaterialType::Stone);
     } else {
         // Generate regular terrain for normal mode
         unsigned int seed = static_cast<unsigned int>(std::time(nullptr));
@@ -130,36 +163,22 @@ int main() {
     int placeBrushSize = 3;  // Size of placement brush
     PixelPhys::MaterialType currentMaterial = PixelPhys::MaterialType::Sand;  // Default material to place
     
-    // Material name mapping for UI display
-    std::map<PixelPhys::MaterialType, std::string> materialNames = {
-        {PixelPhys::MaterialType::Empty, "Eraser"},
-        {PixelPhys::MaterialType::Sand, "Sand"},
-        {PixelPhys::MaterialType::Water, "Water"},
-        {PixelPhys::MaterialType::Stone, "Stone"},
-        {PixelPhys::MaterialType::Fire, "Fire"},
-        {PixelPhys::MaterialType::Oil, "Oil"},
-        {PixelPhys::MaterialType::GrassStalks, "Grass Stalks"},
-        {PixelPhys::MaterialType::Dirt, "Dirt"},
-        {PixelPhys::MaterialType::FlammableGas, "Flammable Gas"},
-        {PixelPhys::MaterialType::Grass, "Grass"},
-        {PixelPhys::MaterialType::Lava, "Lava"},
-        {PixelPhys::MaterialType::Snow, "Snow"},
-        {PixelPhys::MaterialType::Bedrock, "Bedrock"},
-        {PixelPhys::MaterialType::Sandstone, "Sandstone"},
-        {PixelPhys::MaterialType::Gravel, "Gravel"},
-        {PixelPhys::MaterialType::TopSoil, "Top Soil"},
-        {PixelPhys::MaterialType::DenseRock, "Dense Rock"}
-    };
-    
     bool quit = false;
     SDL_Event e;
     Uint32 frameStart, frameTime;
     int frameCount = 0;
     Uint32 fpsTimer = SDL_GetTicks();
     
+    // Real time between frames feeds the world's fixed-timestep clock
+    const double counterFrequency = static_cast<double>(SDL_GetPerformanceFrequency());
+    Uint64 lastCounter = SDL_GetPerformanceCounter();
+    
     // Main loop
     while (!quit) {
         frameStart = SDL_GetTicks();
+        Uint64 counter = SDL_GetPerformanceCounter();
+        double frameSeconds = static_cast<double>(counter - lastCounter) / counterFrequency;
+        lastCounter = counter;
         
         // Process events
         while (SDL_PollEvent(&e) != 0) {
@@ -289,11 +308,7 @@ int main() {
                     int testWidth = 40;
                     int testHeight = 100;
                     
-                    for (int x = testX - testWidth/2; x < testX + testWidth/2; x++) {
-                        for (int y = 50; y < 50 + testHeight; y++) {
-                            world.set(x, y, PixelPhys::MaterialType::Sand);
-                        }
-                    }
+                    world.fillRect(testX - testWidth/2, 50, testWidth, testHeight, PixelPhys::MaterialType::Sand);
                     // std::cout << "Created test column of sand" << std::endl;
                 }
                 else if (e.key.keysym.sym == SDLK_y) {
@@ -302,35 +317,19 @@ int main() {
                     int testWidth = 30;
                     int testHeight = 60;
                     
-                    for (int x = testX - testWidth/2; x < testX + testWidth/2; x++) {
-                        for (int y = 200; y < 200 + testHeight; y++) {
-                            world.set(x, y, PixelPhys::MaterialType::Water);
-                        }
-                    }
+                    world.fillRect(testX - testWidth/2, 200, testWidth, testHeight, PixelPhys::MaterialType::Water);
                     // std::cout << "Created test water pool" << std::endl;
                 }
                 else if (e.key.keysym.sym == SDLK_u) {
                     // Add various materials for visual comparison
                     // Sand
-                    for (int x = 100; x < 130; x++) {
-                        for (int y = 100; y < 130; y++) {
-                            world.set(x, y, PixelPhys::MaterialType::Sand);
-                        }
-                    }
+                    world.fillRect(100, 100, 30, 30, PixelPhys::MaterialType::Sand);
                     
                     // Gravel (more resistant)
-                    for (int x = 150; x < 180; x++) {
-                        for (int y = 100; y < 130; y++) {
-                            world.set(x, y, PixelPhys::MaterialType::Gravel);
-                        }
-                    }
+                    world.fillRect(150, 100, 30, 30, PixelPhys::MaterialType::Gravel);
                     
                     // Dirt
-                    for (int x = 200; x < 230; x++) {
-                        for (int y = 100; y < 130; y++) {
-                            world.set(x, y, PixelPhys::MaterialType::Dirt);
-                        }
-                    }
+                    world.fillRect(200, 100, 30, 30, PixelPhys::MaterialType::Dirt);
                     // std::cout << "Created material comparison test" << std::endl;
                 }
             }
@@ -474,22 +473,8 @@ int main() {
             
             // Handle material placement in camera mode
             if (leftMouseDown) {
-                // Place material in a circular brush pattern
-                for (int dy = -placeBrushSize / 2; dy <= placeBrushSize / 2; dy++) {
-                    for (int dx = -placeBrushSize / 2; dx <= placeBrushSize / 2; dx++) {
-                        // Check if point is within brush radius for circular brush shape
-                        if (dx*dx + dy*dy <= (placeBrushSize/2)*(placeBrushSize/2)) {
-                            // Calculate world coordinates with brush offset
-                            int placeX = worldX + dx;
-                            int placeY = worldY + dy;
-                            
-                            // Ensure we're within world bounds
-                            if (placeX >= 0 && placeX < WORLD_WIDTH && placeY >= 0 && placeY < WORLD_HEIGHT) {
-                                world.set(placeX, placeY, currentMaterial);
-                            }
-                        }
-                    }
-                }
+                // Place material in a circular brush pattern (clipped to the world)
+                world.paintCircle(worldX, worldY, placeBrushSize / 2, currentMaterial);
             }
             
             // Debug output - only show occasionally to avoid console spam
@@ -500,18 +485,19 @@ int main() {
               //             << " | Zoom: 4x | Brush size: " << placeBrushSize << std::endl;
             }
         }
-        // Update the world physics - performance bottleneck
-        world.update();
+        // Chunks on screen get simulated first when the budget runs short
+        world.setView(cameraX, cameraY, actualWidth / PIXEL_SIZE, actualHeight / PIXEL_SIZE);
+        
+        // Run however many simulation ticks the elapsed time covers, so the simulation keeps
+        // its speed when rendering slows down
+        world.advance(frameSeconds);
         
         // Render the world using our renderer with camera position
         renderer->render(world, cameraX, cameraY);
         
         // Display current material and brush size in status bar
-        std::string materialName = "Unknown";
-        auto it = materialNames.find(currentMaterial);
-        if (it != materialNames.end()) {
-            materialName = it->second;
-        }
+        std::string materialName = currentMaterial == PixelPhys::MaterialType::Empty
+                                       ? "Eraser" : PixelPhys::MaterialRegistry::name(currentMaterial);
         // FPS calculation (print FPS every second)
         frameCount++;
         if (SDL_GetTicks() - fpsTimer >= 1000) {